@@ -1,536 +1,2964 @@
-#include "vector.h"
-
-#include <string.h>
-#include <stdio.h>
-
-#define SHIFT(n) ((size_t)1 << n) // fast 2^n
-// this come from stackoverflow, I don't know how it works, but it works
-// carefull, return the biggest power of 2 that is smaller than n, 
-// so need to add 1 to have the smallest power of 2 larger than n
-// don't give 0 to it, it'll return nonsense.
-#define LOG2(X) ((unsigned) (8*sizeof (unsigned long long) - __builtin_clzll((X)) - 1)) 
-#define vec_getInfo(vec) (*(vec_t**)((vec) - sizeof(vec_t*)))
-#define vec_front(vec) ((vec)->baseArr + ((vec)->offset * (vec)->memSize))
-#define vec_back(vec) ((vec)->baseArr + (((vec)->offset + (vec)->size) * (vec)->memSize))
-#define vec_index(vec, i) ((vec)->baseArr + (((vec)->offset + (i)) * (vec)->memSize))
-#define vec_indexFromBack(vec, i) ((vec)->baseArr + (((vec)->offset + (vec)->size - (i)) * (vec)->memSize))
-// the next 3 macros are made based on assumpttions:
-// it assume that index1 and index2 are < vec->size and index1 != index2
-// no need for memmove here as index1 and index2 are assumed different
-// so dest and src should not overlap
-
-// use the unused space at the front of the vector as a temporary buffer
-// assume that offset > 0
-#define vec_swap_front(vecInfo, index1, index2) \
-    memcpy((vecInfo)->baseArr, vec_index(vecInfo, index1), (vecInfo)->memSize); \
-    memcpy(vec_index(vecInfo, index1), vec_index(vecInfo, index2), (vecInfo)->memSize); \
-    memcpy(vec_index(vecInfo, index2), (vecInfo)->baseArr, (vecInfo)->memSize); \
-// use the unused space at the end of the vector as a temporary buffer
-// assume that the array is not full
-#define vec_swap_back(vecInfo, index1, index2) \
-    memcpy(vec_back(vecInfo), vec_index(vecInfo, index1), (vecInfo)->memSize); \
-    memcpy(vec_index(vecInfo, index1), vec_index(vecInfo, index2), (vecInfo)->memSize); \
-    memcpy(vec_index(vecInfo, index2), vec_back(vecInfo), (vecInfo)->memSize); \
-// assume that buff is of size memSize
-#define vec_swap_buff(vecInfo, index1, index2, buff) \
-    memcpy((buff), vec_index(vecInfo, index1), (vecInfo)->memSize); \
-    memcpy(vec_index(vecInfo, index1), vec_index(vecInfo, index2), (vecInfo)->memSize); \
-    memcpy(vec_index(vecInfo, index2), (buff), (vecInfo)->memSize); \
-
-
-static void*(*allocator)(size_t) = malloc;
-static void(*deallocator)(void*) = free;
-
-// the size of the array is 2^(baseSize) and should be able to be stored in a size_t
-// so baseSize can't be bigger than sizeof(size_t) * 8
-// so baseSize should'nt be bigger than 64
-// so can be easily stored in 1 byte, therefore a unsigned char is enough
-typedef struct {
-    void* baseArr; // adress of the allocated array
-    unsigned char baseSize; // log2 of the allocated size for the array
-    size_t size; // number of elem in vec
-    size_t offset; // discarded element in front of the vec
-    size_t memSize; // size of 1 element
-    int (*cmp)(const void*, const void*); // compare function
-} vec_t;
-
-static vec_t* vec_init(size_t memSize, size_t size) {
-    vec_t* vec = allocator(sizeof(vec_t));
-    if(vec == NULL) {
-        fprintf(stderr, "vec_init: malloc failed, requested size: %zu\n", sizeof(vec_t));
-        return NULL;
-    }
-    vec->size = size;
-    // calculate the smallest power of 2 that is bigger than the size
-    vec->baseSize = LOG2(size ? size : 1) + 1;
-    void* baseArr = allocator((memSize * SHIFT(vec->baseSize)) + sizeof(vec_t*));
-    if(baseArr == NULL) {
-        fprintf(stderr, "vec_init: malloc failed, requested size: %zu\n", (memSize * SHIFT(vec->baseSize)) + sizeof(vec_t*));
-        deallocator(vec);
-        return NULL;
-    }
-    vec->baseArr = baseArr + sizeof(vec_t*);
-    memcpy(baseArr, &vec, sizeof(vec_t*));
-    vec->offset = 0;
-    vec->memSize = memSize;
-    vec->cmp = NULL;
-    return vec;
-}
-
-// resize the array to the new baseSize and copy the old array to the new one
-// reset offset to 0
-static void vec_resize(vec_t* vec, size_t newBaseSize) {
-    void* newArr = allocator(vec->memSize * SHIFT(newBaseSize) + sizeof(vec_t*));
-    if(newArr == NULL) {
-        fprintf(stderr, "vec_resize: malloc failed, requested size: %zu\n", vec->memSize * SHIFT(newBaseSize) + sizeof(vec_t*));
-        return;
-    }
-    memcpy(newArr + sizeof(vec_t*), vec_front(vec), vec->size * vec->memSize);
-    memcpy(newArr, &vec, sizeof(vec_t*));
-    deallocator(vec->baseArr - sizeof(vec_t*));
-    vec->baseArr = newArr + sizeof(vec_t*);
-    vec->baseSize = newBaseSize;
-    vec->offset = 0;
-}
-
-// check if the array need to be expanded,
-// if so, double its size
-static void vec_extend(vec_t* vec) {
-    // if size + offset is less than the effective size of the array, do nothing
-    if(vec->size + vec->offset < SHIFT(vec->baseSize)) return;
-    size_t newBaseSize = vec->baseSize + 1;
-    vec_resize(vec, newBaseSize);
-}
-
-// check if the array need to be shrinked,
-// if so, halve its size
-static void vec_shrink(vec_t* vec) {
-    // if baseSize = 0 or size * 2 is greater than the effective size of the array, do nothing
-    if(vec->baseSize == 0) return;
-    if(vec->size * 2 > SHIFT(vec->baseSize)) return;
-    size_t newBaseSize = vec->baseSize - 1;
-    vec_resize(vec, newBaseSize);
-}
-
-// create a new vector of default size size and with a size of elements of memeSize
-void* vec_create(size_t memSize, size_t size) {
-    if(memSize == 0) return NULL;
-    vec_t* darr = vec_init(memSize, size);
-    if(darr == NULL) return NULL;
-    return darr->baseArr;
-}
-
-// push an element at the end of the vector
-static void vec_pushBack(vec_t* vec, void* value) {
-    vec_extend(vec);
-    memcpy(vec_back(vec), value, vec->memSize);
-    vec->size++;
-}
-
-void _vec_priv_pushBack(void** vecPtr, void* value) {
-    if(value == NULL || vecPtr == NULL || *vecPtr == NULL) return;
-    vec_t* vecInfo = vec_getInfo(*vecPtr);
-    vec_pushBack(vecInfo, value);
-    *vecPtr = vec_front(vecInfo);
-}
-
-// push an element at the front of the vector
-static void vec_pushFront(vec_t* vec, void* value) {
-    if(vec->offset > 0) {
-        vec->offset--;
-        vec->size++;
-        memcpy(vec_front(vec), value, vec->memSize);
-        memcpy(vec_front(vec) - sizeof(vec_t*), &vec, sizeof(vec_t*));
-    } else {
-        // create room if needed
-        vec_extend(vec);
-        // shift everything to back of the array
-        vec->offset = SHIFT(vec->baseSize) - vec->size;
-        // if no offset (should not be possible) do nothing,
-        // this is to avoid infinite recursive calls
-        if(vec->offset == 0) return;
-        // need memmove here because everything is moved over itself
-        memmove(vec_front(vec), vec->baseArr, vec->size * vec->memSize);
-        // retry to push the value
-        vec_pushFront(vec,value);
-    }
-}
-
-void _vec_priv_pushFront(void** vecPtr, void* value) {
-    if(value == NULL || vecPtr == NULL || *vecPtr == NULL) return;
-    vec_t* vecInfo = vec_getInfo(*vecPtr);
-    vec_pushFront(vecInfo, value);
-    *vecPtr = vec_front(vecInfo);
-}
-
-// resturn the size of the vector
-size_t vec_size(const void* vec) {
-    if(vec == NULL) return 0;
-    const vec_t* vecInfo = vec_getInfo(vec);
-    return vecInfo->size;
-}
-
-// free the vector
-void vec_free(void* vec) {
-    if(vec == NULL) return;
-    vec_t* arrInfo = *(vec_t**)(vec - sizeof(vec_t*));
-    deallocator(arrInfo->baseArr - sizeof(vec_t*));
-    deallocator(arrInfo);
-}
-
-// store the last element in buff and remove it from the vector
-// if buff is NULL, the element is just deleted
-static void vec_popBack(vec_t* vec, void* buff) {
-    if(vec->size == 0) return;
-    if(buff != NULL) memcpy(buff, vec_indexFromBack(vec, 1), vec->memSize);
-    vec->size--;
-    vec_shrink(vec);
-}
-
-void _vec_priv_popBack(void** vecPtr, void* buff) {
-    if(vecPtr == NULL || *vecPtr == NULL) return;
-    vec_t* vecInfo = vec_getInfo(*vecPtr);
-    if(vecInfo->size == 0) return;
-    vec_popBack(vecInfo, buff);
-    *vecPtr = vec_front(vecInfo);
-}
-
-// store the first element in buff and remove it from the vector
-// if buff is NULL, the element is just deleted
-static void vec_popFront(vec_t* vec, void* buff) {
-    if(vec->size == 0) return;
-    if(buff != NULL) memcpy(buff, vec->baseArr + vec->offset * vec->memSize, vec->memSize);
-    vec->size--;
-    vec->offset++;
-    memcpy(vec_front(vec) - sizeof(vec_t*), &vec, sizeof(vec_t*));
-    vec_shrink(vec);
-}
-
-void _vec_priv_popFront(void** vecPtr, void* buff) {
-    if(vecPtr == NULL || *vecPtr == NULL) return;
-    vec_t* vecInfo = vec_getInfo(*vecPtr);
-    if(vecInfo->size == 0) return;
-    vec_popFront(vecInfo, buff);
-    *vecPtr = vec_front(vecInfo);
-}
-
-// sort the vector using the given comparator
-void vec_sort(void* vec) {
-    if(vec == NULL) return;
-    vec_t* vecInfo = vec_getInfo(vec);
-    if(vecInfo->cmp == NULL) {
-        fprintf(stderr, "Error: vec_sort: no comparator set\n");
-        return;
-    }
-    qsort(vec_front(vecInfo), vecInfo->size, vecInfo->memSize, vecInfo->cmp);
-}
-
-// sort the vector using the comparator given as argument
-void vec_qsort(void* vec, int (*compar_fn) (const void *, const void *)) {
-    if(vec == NULL) return;
-    vec_t* vecInfo = vec_getInfo(vec);
-    qsort(vec_front(vecInfo), vecInfo->size, vecInfo->memSize, compar_fn);
-}
-
-// return a new array containing the elements beetween start and end, end excluded
-void* _vec_priv_slice(void* vec, size_t start, size_t end) {
-    if(vec == NULL) return NULL;
-    vec_t* vecInfo = vec_getInfo(vec);
-    // if start is out of bounds return empty array
-    if(start >= vecInfo->size) return vec_create(vecInfo->memSize, 0);
-    // if end is out of bounds set it to the end of the array
-    if(end > vecInfo->size) end = vecInfo->size;
-    // just create a new array with the right size
-    void* newArr = vec_create(vecInfo->memSize, end - start);
-    // and copy the values
-    memcpy(newArr, vec_index(vecInfo, start), (end - start) * vecInfo->memSize);
-    return newArr;
-}
-
-// insert an element at the given index
-static void vec_insert(vec_t* vecInfo, size_t index, void* value) {
-    if(index > vecInfo->size) return;
-    // if index is at the end, just pushBack
-    if(index >= vecInfo->size) {
-        vec_pushBack(vecInfo, value);
-        return;
-    }
-    // if at the front pushFront
-    if(index == 0) {
-        vec_pushFront(vecInfo, value);
-        return;
-    }
-    vec_extend(vecInfo);
-    // need memmove here because everything is moved over itself by one element
-
-    // case where less elements are at the left of the index and offset != 0
-    if(index < vecInfo->size - index && vecInfo->offset > 0) {
-        // move everything at the left of the index to the left by one element
-        // can access index -1 as offset is > 0
-        memmove(vec_index(vecInfo, -1), vec_front(vecInfo), index * vecInfo->memSize);
-        vecInfo->offset--;
-    } else { 
-        // move everything at the right of the index to the right by one element
-        memmove(vec_index(vecInfo, index + 1), vec_index(vecInfo, index), (vecInfo->size - index) * vecInfo->memSize);
-    }
-    // insert the value
-    memcpy(vec_index(vecInfo, index), value, vecInfo->memSize);
-    vecInfo->size++;
-}
-
-void _vec_priv_insert(void** vecPtr, size_t index, void* value) {
-    if(vecPtr == NULL || *vecPtr == NULL) return;
-    vec_t* vecInfo = vec_getInfo(*vecPtr);
-    vec_insert(vecInfo, index, value);
-    *vecPtr = vec_front(vecInfo);
-}
-
-void _vec_priv_remove(void** vecPtr, size_t index, void* buff) {
-    if(vecPtr == NULL || *vecPtr == NULL) return;
-    vec_t* vecInfo = vec_getInfo(*vecPtr);
-    if(index >= vecInfo->size) return;
-    if(buff != NULL) memcpy(buff, vec_index(vecInfo, index), vecInfo->memSize);
-    // need memmove here because everything is moved over itself by one element
-    memmove(vec_index(vecInfo, index), vec_index(vecInfo, index + 1), (vecInfo->size - index - 1) * vecInfo->memSize);
-    vecInfo->size--;
-    vec_shrink(vecInfo);
-    *vecPtr = vec_front(vecInfo);
-}
-
-
-// swap the elements at the given indexes
-void vec_swap(void* vec, size_t index1, size_t index2) {
-    if(vec == NULL || index1 == index2) return;
-    vec_t* vecInfo = vec_getInfo(vec);
-    if(index1 >= vecInfo->size || index2 >= vecInfo->size) return;
-
-    // the two possibility here avoid the need of a temp buffer
-    // by writing the values directly to unused memory of the array
-    // see functions definitions for more details
-    if(vecInfo->offset != 0) {
-        vec_swap_front(vecInfo, index1, index2);
-        return;
-    } else if(SHIFT(vecInfo->baseSize) > vecInfo->size) {
-        vec_swap_back(vecInfo, index1, index2);
-        return;
-    }
-
-    // maybe allocating the buffer to the stack could be an optimization
-
-    void* buff = allocator(vecInfo->memSize);
-    if(buff == NULL) {
-        fprintf(stderr, "vec_swap: buffer malloc failed, requested size: %zu\n", vecInfo->memSize);
-        return;
-    }
-    vec_swap_buff(vecInfo, index1, index2, buff);
-    deallocator(buff);
-}
-
-// remove all elements from the vector and set its size to 0
-void _vec_priv_clear(void** vecPtr) {
-    if(vecPtr == NULL || *vecPtr == NULL) return;
-    vec_t* vecInfo = vec_getInfo(*vecPtr);
-    // need to set size to 0 now because vec_resize copy the old array
-    vecInfo->size = 0;
-    vec_resize(vecInfo, 0);
-    *vecPtr = vec_front(vecInfo);
-}
-
-
-void _vec_debug_print(void* vec, FILE* stream) {
-    if(vec == NULL) return;
-    vec_t* vecInfo = vec_getInfo(vec);
-    fprintf(stream, "size: %lu, offset: %lu, memSize: %lu, baseSize: %u\n", vecInfo->size, vecInfo->offset, vecInfo->memSize, vecInfo->baseSize);
-    fprintf(stream, "effective memsize: %lu\n", SHIFT(vecInfo->baseSize) * vecInfo->memSize + sizeof(vec_t) + sizeof(vec_t*));
-}
-
-// preallocate the vector to the given size
-static void vec_reserve(vec_t* vec, size_t newSize) {
-    if(newSize <= vec->baseSize) return;
-    size_t newBaseSize = LOG2(newSize ? newSize : 1) + 1;
-    if(newBaseSize > vec->baseSize) {
-        vec_resize(vec, newBaseSize);
-    }
-}
-
-// preallocates the vector to the given size and if resize is true set its size to the given size
-void vec_allocate(void* vecPtr, size_t newSize, int resize) {
-    if(vecPtr == NULL || *(void**)vecPtr == NULL) return;
-    vec_t* vecInfo = vec_getInfo(*(void**)vecPtr);
-    vec_reserve(vecInfo, newSize);
-    if(resize) vecInfo->size = newSize;
-    *(void**)vecPtr = vec_front(vecInfo);
-}
-
-// reverse the vector
-void vec_reverse(void* vec) {
-    if(vec == NULL) return;
-    vec_t* vecInfo = vec_getInfo(vec);
-    // no need for memmove here as i is strictly inferior to j,
-    // so i always different from j
-    // so dest and src can't overlap
-
-    // the two possibility here avoid the need of a temp buffer
-    // by writing the values directly to the array
-    if(vecInfo->offset != 0) {
-        for(size_t i = 0, j = vecInfo->size - 1; i < j; i++, j--) {
-            vec_swap_front(vecInfo, i, j);
-        }
-        return;
-    } else if(SHIFT(vecInfo->baseSize) > vecInfo->size) {
-        for(size_t i = 0, j = vecInfo->size - 1; i < j; i++, j--) {
-            vec_swap_back(vecInfo, i, j);
-        }
-        return;
-    }
-
-    // same as vec_swap, maybe allocating the buffer to the stack
-    void* buff = allocator(vecInfo->memSize);
-    if(buff == NULL) {
-        fprintf(stderr, "vec_reverse: buffer malloc failed, requested size: %zu\n", vecInfo->memSize);
-        return;
-    }
-    for(size_t i = 0, j = vecInfo->size - 1; i < j; i++, j--) {
-        vec_swap_buff(vecInfo, i, j, buff);
-    }
-    deallocator(buff);
-}
-
-// set theallocator function
-void vec_set_allocator(void* (*_allocator)(size_t)) {
-    allocator = _allocator;
-}
-
-// set the deallocator function
-void vec_set_deallocator(void (*_deallocator)(void*)) {
-    deallocator = _deallocator;
-}
-
-// set the comparator function for the vector
-void vec_setComparator(void* vec, int (*cmp)(const void*, const void*)) {
-    if(vec == NULL) return;
-    vec_t* vecInfo = vec_getInfo(vec);
-    vecInfo->cmp = cmp;
-}
-
-// return the index where the element should be inserted to keep the vector sorted
-static size_t vec_find_sorted_insertion(const vec_t* vecInfo, const void* value) {
-    if(vecInfo->cmp == NULL) {
-        fprintf(stderr, "vec_find_sorted_insertion: no compare function set\n");
-        return vecInfo->size;
-    }
-    size_t i = 0, j = vecInfo->size, m;
-    // don't search an equal value, but rather the insertion point
-    // loop until finding m such as
-    // the value at index m - 1 is smaller or equal to the value
-    // and the value at index m is greater to the value
-    // in case value is the smallest value, the insertion point is 0
-    // in case value is the largest value, the insertion point is vecInfo->size
-    // this is not that much more heavy work, as it will just always reach worst case scenario of a "normal" bsearch
-    while(i < j) {
-        m = (i + j) / 2;
-        if(vecInfo->cmp(vec_index(vecInfo, m), value) <= 0) {
-            i = m + 1;
-        } else {
-            j = m;
-        }
-    }
-    return i;
-}
-
-// insert the value at the right place to keep the array sorted
-// assume that the array is already sorted
-size_t _vec_priv_sortedInsert(void** vecPtr, void* value) {
-    if(vecPtr == NULL || *vecPtr == NULL) return 0;
-    vec_t* vecInfo = vec_getInfo(*vecPtr);
-    size_t i = vec_find_sorted_insertion(vecInfo, value);
-    vec_insert(vecInfo, i, value);
-    *vecPtr = vec_front(vecInfo);
-    return i;
-}
-
-// return if the array is sorted, do a linear comparaison
-int vec_isSorted(const void* vec) {
-    if(vec == NULL) return 1;
-    const vec_t* vecInfo = vec_getInfo(vec);
-    if(vecInfo->cmp == NULL) {
-        fprintf(stderr, "vec_isSorted: no compare function set\n");
-        return 0;
-    }
-    for(size_t i = 1; i < vecInfo->size; i++) {
-        if(vecInfo->cmp(vec_index(vecInfo, i - 1), vec_index(vecInfo, i)) > 0) {
-            return 0;
-        }
-    }
-    return 1;
-}
-
-/**
- * 
- * TLDR: I'm doing black magic in C, and it work better than it should.
- * 
- * 
- * I will try to explain the inner workings of this code, which is pure black magic,
- * and will surely make some people mad.
- * (first thing, the struct vec_t contain the infos about the vector.)
- * When I tried to design this lib for the first time, 
- * I gave back the struct to the user and he add to access an array in the struct
- * But it was not practical, and I wanted to just do vec[i] = x, and not vec.arr[i] = x
- * so I gave back the array to the user and he can access it with the [] operator.
- * but now, how do I access the info when the user want to push item or the size?
- * well at first I've done the most stupid things that came to my mind, 
- * I just created an array that store the infos of all the current vec, 
- * and do a bsearch when I need to access the info of a vec.
- * so as you can imagine, I need to sort the array everytime the vec address change,
- * so most of the workload was sorting and searching in an array.
- * but now, I use some address pointers tricks to make it more efficient.
- * when I allocate the memory for the array, I also allocate the size of an address to the struct vec_t
- * so instead of allocating size * memSize, I allocate size * memSize + sizeof(vec_t*)
- * and I give back the address, but shifted of sizeof(vec_t*)
- * so when the user use functions on the vector, I just shift it back to retrieve the address
- * (see macro vec_getInfo(vec))
- * I don't know if its the best, if it's really safe, but it works, and it's fast, 
- * and it's very convenient, for the user and for me.
- * 
- * user could use the "privates" functions of the library, but the prefered way is to define wrapper functions.
- * macros to define them are defines in the header file.
- * most of the functions are inlined so it does'nt create actual functions, and can be defined in multiple files
- * without creating the same function multiple times, 
- * and the compiler can optimize them as they are very small wrappers.
- * 
- * An other thing, I'm not an expert in dynammic arrays, so I just implemented
- * a logic I came accross one time, and I've done it the way that seams the best for me.
- * in vect_t, the property baseSize is an power of 2 of the actual size of the array,
- * so the array size is 2^(baseSize)
- * yes this means that there is unused memory in the array, but this make insertion and deletion
- * fast as they are now O(log(n)) instead of O(n))
- * (I speak in term of reallocation, which mean copying the array, only log2(n) times instead of n times)
- * I also heard about the fact that computer likes to always be propare that functions are gonna be call multiple
- * so when the user push to the front, if their is no space at the front, I move the array to the back,
- * not just of one element, but of the whole array.
- * I do the smae thing when the user push to the back, I just move the array to the front, setting the offset to 0.
- * This whole logic is done in vec_expand() and vec_shrink(), which are just wrappers for vec_resize().
- * no other functions than vec_resize() should resize, only move memory.
- * all function that insert element in the vector call vec_expand(),
- * and all function that remove element from the vector call vec_shrink().
- * this insure that the array is always in the right size.
- * the only function that can oversize the array is vec_reserve() (which is also a wrapper for vec_resize())
- * 
- * some macro are defined to access part of the array, see vec_: front, back, index, indexFromBack
- * defined to make the code more readeable when moving memory around.
- * 
- * functions that intend to modify the vec size take the vec address as first argument,
- * that way the memory address of the arr can be replaced by the new one if the array is resized.
- * so all these function finish by *vecPtr = vec_front(vecInfo)
- * 
- * 
- * I hope the code is not too hard to understand, I try to keep it as clean as possible,
- * but this is difficult has it's mostly memory movement.
- * this lib is just me tweaking around in C to improve myself,
- * I'm sure most of the functions could be written in a better way and more optimized,
- * If you see any improvement, please let me know.
- * 
- * Thanks for reading,
- * have a nice day,
- * Baptiste de Montangon.
- */
+// for mremap
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "vector.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#ifdef __linux__
+#include <sys/mman.h>
+#define VEC_USE_MMAP
+#endif
+
+#define SHIFT(n) ((size_t)1 << (n)) // fast 2^n
+// this come from stackoverflow, I don't know how it works, but it works
+// carefull, return the biggest power of 2 that is smaller than n, 
+// so need to add 1 to have the smallest power of 2 larger than n
+// don't give 0 to it, it'll return nonsense.
+#define LOG2(X) ((unsigned) (8*sizeof (unsigned long long) - __builtin_clzll((X)) - 1)) 
+#define vec_getInfo(vec) (*(vec_t**)((vec) - sizeof(vec_t*)))
+// the infos and the array are in the same allocation:
+// [vec_t][padding][vec_t*][element 0][element 1]...
+// the vec_t* slot is the address stored in front of the array when offset = 0
+// the padding (up to align - 1 bytes) is there so the array start on a multiple of align
+#define vec_allocSize(memSize, capacity, align) (sizeof(vec_t) + sizeof(vec_t*) + (align) - 1 + (memSize) * (capacity))
+#define vec_allocSizeOf(vec) vec_allocSize((vec)->memSize, (vec)->capacity, (vec)->align)
+// smallest capacity of an array, so small arrays don't resize on every push
+#define VEC_MIN_CAPACITY 4
+#define vec_arrFromInfo(vec) \
+    ((void*)(((uintptr_t)((vec) + 1) + sizeof(vec_t*) + (vec)->align - 1) & ~(uintptr_t)((vec)->align - 1)))
+#define vec_front(vec) ((vec)->baseArr + ((vec)->offset * (vec)->memSize))
+#define vec_back(vec) ((vec)->baseArr + (((vec)->offset + (vec)->size) * (vec)->memSize))
+#define vec_index(vec, i) ((vec)->baseArr + (((vec)->offset + (i)) * (vec)->memSize))
+#define vec_indexFromBack(vec, i) ((vec)->baseArr + (((vec)->offset + (vec)->size - (i)) * (vec)->memSize))
+// true if one element fit at the front of the array without overwriting the address stored in front of it
+#define vec_hasFrontRoom(vec) ((vec)->offset * (vec)->memSize >= (vec)->memSize + sizeof(vec_t*))
+// the next 3 macros are made based on assumpttions:
+// it assume that index1 and index2 are < vec->size and index1 != index2
+// no need for memmove here as index1 and index2 are assumed different
+// so dest and src should not overlap
+
+// use the unused space at the front of the vector as a temporary buffer
+// assume that there is room for an element before the address stored in front of the array
+// (see vec_hasFrontRoom)
+#define vec_swap_front(vecInfo, index1, index2) \
+    memcpy((vecInfo)->baseArr, vec_index(vecInfo, index1), (vecInfo)->memSize); \
+    memcpy(vec_index(vecInfo, index1), vec_index(vecInfo, index2), (vecInfo)->memSize); \
+    memcpy(vec_index(vecInfo, index2), (vecInfo)->baseArr, (vecInfo)->memSize); \
+// use the unused space at the end of the vector as a temporary buffer
+// assume that the array is not full
+#define vec_swap_back(vecInfo, index1, index2) \
+    memcpy(vec_back(vecInfo), vec_index(vecInfo, index1), (vecInfo)->memSize); \
+    memcpy(vec_index(vecInfo, index1), vec_index(vecInfo, index2), (vecInfo)->memSize); \
+    memcpy(vec_index(vecInfo, index2), vec_back(vecInfo), (vecInfo)->memSize); \
+// assume that buff is of size memSize
+#define vec_swap_buff(vecInfo, index1, index2, buff) \
+    memcpy((buff), vec_index(vecInfo, index1), (vecInfo)->memSize); \
+    memcpy(vec_index(vecInfo, index1), vec_index(vecInfo, index2), (vecInfo)->memSize); \
+    memcpy(vec_index(vecInfo, index2), (buff), (vecInfo)->memSize); \
+
+
+// external definitions of the inline functions of the header that are not wrappers
+extern inline uint64_t _vec_priv_radixKey_signed(long long x, size_t size);
+extern inline uint64_t _vec_priv_radixKey_float(float x);
+extern inline uint64_t _vec_priv_radixKey_double(double x);
+extern inline size_t vec_find_int(const int* vec, int value);
+extern inline size_t vec_count_int(const int* vec, int value);
+extern inline int vec_min_int(const int* vec);
+extern inline int vec_max_int(const int* vec);
+extern inline long long vec_sum_int(const int* vec);
+extern inline size_t vec_find_float(const float* vec, float value);
+extern inline size_t vec_count_float(const float* vec, float value);
+extern inline float vec_min_float(const float* vec);
+extern inline float vec_max_float(const float* vec);
+extern inline double vec_sum_float(const float* vec);
+extern inline size_t vec_find_double(const double* vec, double value);
+extern inline size_t vec_count_double(const double* vec, double value);
+extern inline double vec_min_double(const double* vec);
+extern inline double vec_max_double(const double* vec);
+extern inline double vec_sum_double(const double* vec);
+extern inline size_t vec_find_int64(const int64_t* vec, int64_t value);
+extern inline size_t vec_count_int64(const int64_t* vec, int64_t value);
+extern inline int64_t vec_min_int64(const int64_t* vec);
+extern inline int64_t vec_max_int64(const int64_t* vec);
+extern inline int64_t vec_sum_int64(const int64_t* vec);
+extern inline void* vec_view_at(vec_view_t view, size_t index);
+extern inline size_t vec_view_find_int(vec_view_t view, int value);
+extern inline size_t vec_view_count_int(vec_view_t view, int value);
+extern inline int vec_view_min_int(vec_view_t view);
+extern inline int vec_view_max_int(vec_view_t view);
+extern inline long long vec_view_sum_int(vec_view_t view);
+extern inline size_t vec_view_find_float(vec_view_t view, float value);
+extern inline size_t vec_view_count_float(vec_view_t view, float value);
+extern inline float vec_view_min_float(vec_view_t view);
+extern inline float vec_view_max_float(vec_view_t view);
+extern inline double vec_view_sum_float(vec_view_t view);
+extern inline size_t vec_view_find_double(vec_view_t view, double value);
+extern inline size_t vec_view_count_double(vec_view_t view, double value);
+extern inline double vec_view_min_double(vec_view_t view);
+extern inline double vec_view_max_double(vec_view_t view);
+extern inline double vec_view_sum_double(vec_view_t view);
+extern inline size_t vec_view_find_int64(vec_view_t view, int64_t value);
+extern inline size_t vec_view_count_int64(vec_view_t view, int64_t value);
+extern inline int64_t vec_view_min_int64(vec_view_t view);
+extern inline int64_t vec_view_max_int64(vec_view_t view);
+extern inline int64_t vec_view_sum_int64(vec_view_t view);
+extern inline uint64_t _vec_priv_hashMix(uint64_t h);
+extern inline unsigned _vec_priv_hashMatch(const uint8_t* group, uint8_t h2);
+extern inline unsigned _vec_priv_hashMatchFree(const uint8_t* group);
+
+static void*(*allocator)(size_t) = malloc;
+static void*(*reallocator)(void*, size_t) = realloc;
+static void(*deallocator)(void*) = free;
+
+// when the library use malloc, blocks of at least VEC_MMAP_THRESHOLD bytes are mapped directly,
+// so growing them with mremap only remap the pages instead of copying gigabytes.
+// the arrays switch to the allocator of the mappings when they get that big (see vec_blockAllocator),
+// so a mapped block is unmapped even if the allocator functions of the library changed since.
+#ifndef VEC_MMAP_THRESHOLD
+#define VEC_MMAP_THRESHOLD ((size_t)1 << 26)
+#endif
+#define vec_useMmap(size) ((size) >= VEC_MMAP_THRESHOLD && allocator == malloc && deallocator == free)
+
+// per thread cache of the blocks freed by the default allocator, see vec_cache_setLimits()
+// the blocks are kept in a list per power of 2 size class (rounded down, so any block of a class
+// is at least as big as the class), with their size stored in them.
+// an allocation only look in the class of its size, for a block at least as big.
+#ifndef VEC_CACHE_MAX_BLOCK
+#define VEC_CACHE_MAX_BLOCK ((size_t)1 << 20)
+#endif
+#define VEC_CACHE_CLASSES 64
+
+typedef struct vec_cacheBlock_s {
+    struct vec_cacheBlock_s* next;
+    size_t size;
+} vec_cacheBlock_t;
+
+typedef struct {
+    vec_cacheBlock_t* lists[VEC_CACHE_CLASSES];
+    size_t counts[VEC_CACHE_CLASSES];
+    size_t bytes; // bytes kept by the cache
+    int registered; // the destructor of the thread is set
+} vec_cache_t;
+
+static _Thread_local vec_cache_t vecCache;
+// limits shared by all threads, maxBlocks = 0 disable the cache
+static size_t vecCacheMaxBlocks = 0;
+static size_t vecCacheMaxBytes = 0;
+static size_t vecCacheMaxBlockSize = VEC_CACHE_MAX_BLOCK;
+static pthread_key_t vecCacheKey;
+static pthread_once_t vecCacheKeyOnce = PTHREAD_ONCE_INIT;
+
+#define vec_cacheLimit(limit) __atomic_load_n(&(limit), __ATOMIC_RELAXED)
+#define vec_cacheable(size) \
+    ((size) >= sizeof(vec_cacheBlock_t) && (size) <= vec_cacheLimit(vecCacheMaxBlockSize) && vec_cacheLimit(vecCacheMaxBlocks) > 0)
+
+static void vec_cacheThreadExit(void* cache) {
+    vec_cache_trim();
+}
+
+static void vec_cacheCreateKey(void) {
+    pthread_key_create(&vecCacheKey, vec_cacheThreadExit);
+}
+
+// take a block of at least size bytes from the cache of the thread, NULL if there is none
+static void* vec_cacheTake(size_t size) {
+    if(!vec_cacheable(size)) return NULL;
+    unsigned sizeClass = LOG2(size);
+    vec_cacheBlock_t** prev = &vecCache.lists[sizeClass];
+    for(vec_cacheBlock_t* block = *prev; block != NULL; prev = &block->next, block = block->next) {
+        if(block->size >= size) {
+            *prev = block->next;
+            vecCache.counts[sizeClass]--;
+            vecCache.bytes -= block->size;
+            return block;
+        }
+    }
+    return NULL;
+}
+
+// keep the block in the cache of the thread, return 0 if it's full
+static int vec_cachePut(void* ptr, size_t size) {
+    if(!vec_cacheable(size)) return 0;
+    unsigned sizeClass = LOG2(size);
+    if(vecCache.counts[sizeClass] >= vec_cacheLimit(vecCacheMaxBlocks)
+        || vecCache.bytes + size > vec_cacheLimit(vecCacheMaxBytes)) {
+        return 0;
+    }
+    if(!vecCache.registered) {
+        // the cache is trimmed when the thread exit
+        pthread_once(&vecCacheKeyOnce, vec_cacheCreateKey);
+        pthread_setspecific(vecCacheKey, &vecCache);
+        vecCache.registered = 1;
+    }
+    vec_cacheBlock_t* block = ptr;
+    block->size = size;
+    block->next = vecCache.lists[sizeClass];
+    vecCache.lists[sizeClass] = block;
+    vecCache.counts[sizeClass]++;
+    vecCache.bytes += size;
+    return 1;
+}
+
+// allocator of the arrays created without one, forward to the allocator of the library
+// freed blocks go through the cache of the thread when it's enabled
+static void* vec_defaultAlloc(void* ctx, size_t size) {
+    void* cached = vec_cacheTake(size);
+    if(cached != NULL) return cached;
+    return allocator(size);
+}
+
+static void vec_defaultFree(void* ctx, void* ptr, size_t size) {
+    if(vec_cachePut(ptr, size)) return;
+    deallocator(ptr);
+}
+
+static void* vec_defaultRealloc(void* ctx, void* ptr, size_t oldSize, size_t newSize) {
+    // a cached block avoid the allocator, else realloc may grow the block in place
+    void* newPtr = vec_cacheTake(newSize);
+    if(newPtr == NULL) {
+        if(reallocator != NULL) return reallocator(ptr, newSize);
+        newPtr = allocator(newSize);
+        if(newPtr == NULL) return NULL;
+    }
+    memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+    vec_defaultFree(ctx, ptr, oldSize);
+    return newPtr;
+}
+
+static const vec_allocator_t defaultAllocator = { vec_defaultAlloc, vec_defaultRealloc, vec_defaultFree, NULL };
+
+#ifdef VEC_USE_MMAP
+// allocator of the big blocks of the arrays using the default allocator
+static void* vec_mapAlloc(void* ctx, size_t size) {
+    void* ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return ptr == MAP_FAILED ? NULL : ptr;
+}
+
+static void vec_mapFree(void* ctx, void* ptr, size_t size) {
+    munmap(ptr, size);
+}
+
+static void* vec_mapRealloc(void* ctx, void* ptr, size_t oldSize, size_t newSize) {
+    void* newPtr = mremap(ptr, oldSize, newSize, MREMAP_MAYMOVE);
+    return newPtr == MAP_FAILED ? NULL : newPtr;
+}
+
+static const vec_allocator_t mapAllocator = { vec_mapAlloc, vec_mapRealloc, vec_mapFree, NULL };
+#endif
+
+// allocator to use for a block of size bytes of an array using alloc,
+// the arrays of the default allocator have their big blocks mapped
+static const vec_allocator_t* vec_blockAllocator(const vec_allocator_t* alloc, size_t size) {
+#ifdef VEC_USE_MMAP
+    if(alloc == &mapAllocator) alloc = &defaultAllocator;
+    if(alloc == &defaultAllocator && vec_useMmap(size)) return &mapAllocator;
+#endif
+    return alloc;
+}
+
+typedef struct {
+    void* baseArr; // adress of the allocated array
+    size_t capacity; // number of elements the allocated array can hold
+    unsigned short growthPercent; // the capacity is multiplied by growthPercent / 100 when the array is full
+    unsigned char shrinkRatio; // the array is shrinked when size * shrinkRatio <= capacity, 0 to never shrink
+    size_t size; // number of elem in vec
+    size_t offset; // discarded element in front of the vec
+    size_t memSize; // size of 1 element
+    int (*cmp)(const void*, const void*); // compare function
+    const vec_allocator_t* alloc; // allocator of the array (and of the infos)
+    size_t align; // alignment of the front element, 1 if the array has no alignment
+#ifdef VEC_STATS
+    vec_stats_t stats; // counters of this array
+#endif
+} vec_t;
+
+// counters are only compiled with VEC_STATS defined, so they cost nothing in normal builds
+// each counter is added to the array and to the global stats
+#ifdef VEC_STATS
+static vec_stats_t globalStats;
+
+#define vec_statAdd(vec, field, n) do { \
+        (vec)->stats.field += (n); \
+        __atomic_fetch_add(&globalStats.field, (n), __ATOMIC_RELAXED); \
+    } while(0)
+
+// update the allocated bytes of the array and the global ones, and their peaks
+static void vec_statAllocated(vec_t* vec, size_t oldSize, size_t newSize) {
+    vec->stats.allocatedBytes += newSize - oldSize;
+    if(vec->stats.allocatedBytes > vec->stats.peakBytes) vec->stats.peakBytes = vec->stats.allocatedBytes;
+    size_t current = __atomic_add_fetch(&globalStats.allocatedBytes, newSize - oldSize, __ATOMIC_RELAXED);
+    size_t peak = __atomic_load_n(&globalStats.peakBytes, __ATOMIC_RELAXED);
+    while(current > peak && !__atomic_compare_exchange_n(&globalStats.peakBytes, &peak, current, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+// allocation failures can happen before the array exist, so they are only global
+#define vec_statFailure() __atomic_fetch_add(&globalStats.allocFailures, 1, __ATOMIC_RELAXED)
+#else
+#define vec_statAdd(vec, field, n)
+#define vec_statAllocated(vec, oldSize, newSize) ((void)(oldSize), (void)(newSize))
+#define vec_statFailure()
+#endif
+
+// memmove inside the array, counted in the stats
+#define vec_memmove(vec, dest, src, n) do { \
+        memmove((dest), (src), (n)); \
+        vec_statAdd(vec, bytesMoved, (n)); \
+    } while(0)
+
+// number of elements the front can move by while staying aligned,
+// the smallest count such as count * memSize is a multiple of align
+static size_t vec_alignStep(const vec_t* vec) {
+    size_t lowBit = vec->memSize & -vec->memSize;
+    return lowBit >= vec->align ? 1 : vec->align / lowBit;
+}
+
+// if the front is not aligned anymore, move the elements to the left to the closest aligned position
+// called after the functions moving the front of aligned arrays
+static vec_t* vec_alignFront(vec_t* vec) {
+    size_t step = vec_alignStep(vec);
+    if(vec->offset % step == 0) return vec;
+    size_t newOffset = vec->offset - vec->offset % step;
+    vec_memmove(vec, vec->baseArr + newOffset * vec->memSize, vec_front(vec), vec->size * vec->memSize);
+    vec->offset = newOffset;
+    memcpy(vec_front(vec) - sizeof(vec_t*), &vec, sizeof(vec_t*));
+    return vec;
+}
+
+static vec_t* vec_init(size_t memSize, size_t size, const vec_allocator_t* alloc, size_t align) {
+    // the array is allocated for exactly size elements
+    size_t capacity = size > VEC_MIN_CAPACITY ? size : VEC_MIN_CAPACITY;
+    alloc = vec_blockAllocator(alloc, vec_allocSize(memSize, capacity, align));
+    vec_t* vec = alloc->alloc(alloc->ctx, vec_allocSize(memSize, capacity, align));
+    if(vec == NULL) {
+        fprintf(stderr, "vec_init: malloc failed, requested size: %zu\n", vec_allocSize(memSize, capacity, align));
+        vec_statFailure();
+        return NULL;
+    }
+    vec->size = size;
+    vec->capacity = capacity;
+    vec->align = align;
+    vec->baseArr = vec_arrFromInfo(vec);
+    memcpy(vec->baseArr - sizeof(vec_t*), &vec, sizeof(vec_t*));
+    vec->offset = 0;
+    vec->memSize = memSize;
+    vec->cmp = NULL;
+    vec->alloc = alloc;
+    vec->growthPercent = VEC_DEFAULT_GROWTH;
+    vec->shrinkRatio = VEC_DEFAULT_SHRINK;
+#ifdef VEC_STATS
+    memset(&vec->stats, 0, sizeof(vec_stats_t));
+#endif
+    vec_statAllocated(vec, 0, vec_allocSizeOf(vec));
+    return vec;
+}
+
+// resize the array to the new capacity and copy the old array to the new one
+// reset offset to 0
+// as the infos are allocated with the array, they move too,
+// so return the new address of the infos (or the old one if the allocation failed)
+static vec_t* vec_resize(vec_t* vec, size_t newCapacity) {
+    const vec_allocator_t* alloc = vec->alloc;
+    size_t newAllocSize = vec_allocSize(vec->memSize, newCapacity, vec->align);
+    // the block can go from or to a mapping, then it's moved from one allocator to the other
+    const vec_allocator_t* newAlloc = vec_blockAllocator(alloc, newAllocSize);
+    // the elements are already at the start of the block, let the allocator grow it in place (or remap it)
+    if(newAlloc == alloc && vec->offset == 0 && alloc->realloc != NULL) {
+        size_t arrOffset = vec->baseArr - (void*)vec;
+        vec_t* newVec = alloc->realloc(alloc->ctx, vec, vec_allocSizeOf(vec), newAllocSize);
+        if(newVec == NULL) {
+            fprintf(stderr, "vec_resize: realloc failed, requested size: %zu\n", newAllocSize);
+            vec_statFailure();
+            return vec;
+        }
+        size_t oldAllocSize = vec_allocSizeOf(newVec);
+        newVec->baseArr = vec_arrFromInfo(newVec);
+        // for aligned arrays, the padding change if the block moved to an address with an other alignment
+        if(newVec->baseArr != (void*)newVec + arrOffset) {
+            memmove(newVec->baseArr, (void*)newVec + arrOffset, newVec->size * newVec->memSize);
+            vec_statAdd(newVec, bytesCopied, newVec->size * newVec->memSize);
+        }
+        memcpy(newVec->baseArr - sizeof(vec_t*), &newVec, sizeof(vec_t*));
+        newVec->capacity = newCapacity;
+        vec_statAdd(newVec, resizes, 1);
+        vec_statAllocated(newVec, oldAllocSize, newAllocSize);
+        return newVec;
+    }
+    vec_t* newVec = newAlloc->alloc(newAlloc->ctx, newAllocSize);
+    if(newVec == NULL) {
+        fprintf(stderr, "vec_resize: malloc failed, requested size: %zu\n", newAllocSize);
+        vec_statFailure();
+        return vec;
+    }
+    *newVec = *vec;
+    newVec->alloc = newAlloc;
+    newVec->baseArr = vec_arrFromInfo(newVec);
+    memcpy(newVec->baseArr, vec_front(vec), vec->size * vec->memSize);
+    memcpy(newVec->baseArr - sizeof(vec_t*), &newVec, sizeof(vec_t*));
+    size_t oldAllocSize = vec_allocSizeOf(vec);
+    alloc->free(alloc->ctx, vec, oldAllocSize);
+    newVec->capacity = newCapacity;
+    newVec->offset = 0;
+    vec_statAdd(newVec, resizes, 1);
+    vec_statAdd(newVec, bytesCopied, newVec->size * newVec->memSize);
+    vec_statAllocated(newVec, oldAllocSize, vec_allocSizeOf(newVec));
+    return newVec;
+}
+
+// check if the array has room for count more elements at the back,
+// if not, grow it by the growth factor of the vector (or more if count need it)
+static vec_t* vec_extendN(vec_t* vec, size_t count) {
+    // if size + offset + count fit in the effective size of the array, do nothing
+    if(vec->size + vec->offset + count <= vec->capacity) return vec;
+    // if the array would be at most half full, the room is wasted at the front,
+    // so just move the elements back to the start instead of reallocating
+    // (happens when the array is used as a queue, pushBack + popFront)
+    if((vec->size + count) * 2 <= vec->capacity) {
+        vec_memmove(vec, vec->baseArr, vec_front(vec), vec->size * vec->memSize);
+        vec->offset = 0;
+        // popFront may have partially overwritten the address in front of the array
+        memcpy(vec->baseArr - sizeof(vec_t*), &vec, sizeof(vec_t*));
+        return vec;
+    }
+    // capacity * growthPercent / 100, without overflowing for big arrays
+    size_t newCapacity = vec->capacity / 100 * vec->growthPercent + vec->capacity % 100 * vec->growthPercent / 100;
+    if(newCapacity <= vec->capacity) newCapacity = vec->capacity + 1;
+    if(newCapacity < vec->size + count) newCapacity = vec->size + count;
+    return vec_resize(vec, newCapacity);
+}
+
+// check if the array need to be expanded,
+// if so, grow it by the growth factor of the vector
+static vec_t* vec_extend(vec_t* vec) {
+    return vec_extendN(vec, 1);
+}
+
+// check if the array need to be shrinked,
+// if so, resize it to the middle of the range allowed by the policy (size * shrinkRatio / 2),
+// so it doesn't grow or shrink again right away
+static vec_t* vec_shrink(vec_t* vec) {
+    // if shrinking is disabled or size * shrinkRatio
+    // is greater than the capacity of the array, do nothing
+    if(vec->shrinkRatio == VEC_SHRINK_NEVER) return vec;
+    if(vec->size * vec->shrinkRatio > vec->capacity) return vec;
+    size_t newCapacity = vec->size * vec->shrinkRatio / 2;
+    if(newCapacity < VEC_MIN_CAPACITY) newCapacity = VEC_MIN_CAPACITY;
+    if(newCapacity >= vec->capacity) return vec;
+    return vec_resize(vec, newCapacity);
+}
+
+// create a new vector of default size size and with a size of elements of memeSize
+void* vec_create(size_t memSize, size_t size) {
+    return vec_create_with_allocator(memSize, size, NULL);
+}
+
+// same as vec_create, with the memory coming from the given allocator
+void* vec_create_with_allocator(size_t memSize, size_t size, const vec_allocator_t* alloc) {
+    if(memSize == 0) return NULL;
+    vec_t* darr = vec_init(memSize, size, alloc ? alloc : &defaultAllocator, 1);
+    if(darr == NULL) return NULL;
+    return darr->baseArr;
+}
+
+// same as vec_create, with the front element aligned on align bytes
+void* vec_create_aligned(size_t memSize, size_t size, size_t align) {
+    if(memSize == 0 || align == 0 || (align & (align - 1)) != 0) return NULL;
+    vec_t* darr = vec_init(memSize, size, &defaultAllocator, align);
+    if(darr == NULL) return NULL;
+    return darr->baseArr;
+}
+
+// push an element at the end of the vector
+static vec_t* vec_pushBack(vec_t* vec, void* value) {
+    vec = vec_extend(vec);
+    memcpy(vec_back(vec), value, vec->memSize);
+    vec->size++;
+    return vec;
+}
+
+void _vec_priv_pushBack(void** vecPtr, void* value) {
+    if(value == NULL || vecPtr == NULL || *vecPtr == NULL) return;
+    vec_t* vecInfo = vec_getInfo(*vecPtr);
+    vecInfo = vec_pushBack(vecInfo, value);
+    *vecPtr = vec_front(vecInfo);
+}
+
+// push an element at the front of the vector
+static vec_t* vec_pushFront(vec_t* vec, void* value) {
+    if(vec->offset > 0) {
+        vec->offset--;
+        vec->size++;
+        memcpy(vec_front(vec), value, vec->memSize);
+        memcpy(vec_front(vec) - sizeof(vec_t*), &vec, sizeof(vec_t*));
+        return vec_alignFront(vec);
+    } else {
+        // create room if needed
+        vec = vec_extend(vec);
+        // shift everything to back of the array
+        vec->offset = vec->capacity - vec->size;
+        // if no offset (should not be possible) do nothing,
+        // this is to avoid infinite recursive calls
+        if(vec->offset == 0) return vec;
+        // need memmove here because everything is moved over itself
+        memmove(vec_front(vec), vec->baseArr, vec->size * vec->memSize);
+        vec_statAdd(vec, bytesRebased, vec->size * vec->memSize);
+        // retry to push the value
+        return vec_pushFront(vec,value);
+    }
+}
+
+void _vec_priv_pushFront(void** vecPtr, void* value) {
+    if(value == NULL || vecPtr == NULL || *vecPtr == NULL) return;
+    vec_t* vecInfo = vec_getInfo(*vecPtr);
+    vecInfo = vec_pushFront(vecInfo, value);
+    *vecPtr = vec_front(vecInfo);
+}
+
+// growing the vector can move or free its elements, so values taken from the vector itself
+// are copied to a temporary buffer first, that need to be freed by the caller (*buff)
+static const void* vec_unaliasValues(const vec_t* vec, const void* values, size_t count, void** buff) {
+    uintptr_t start = (uintptr_t)vec_front(vec);
+    uintptr_t ptr = (uintptr_t)values;
+    *buff = NULL;
+    if(ptr < start || ptr >= start + vec->size * vec->memSize) return values;
+    *buff = allocator(count * vec->memSize);
+    if(*buff != NULL) memcpy(*buff, values, count * vec->memSize);
+    return *buff;
+}
+
+// push count elements at the end of the vector, growing it only once
+static vec_t* vec_pushBackN(vec_t* vec, const void* values, size_t count) {
+    vec = vec_extendN(vec, count);
+    memcpy(vec_back(vec), values, count * vec->memSize);
+    vec->size += count;
+    return vec;
+}
+
+void _vec_priv_pushBackN(void** vecPtr, const void* values, size_t count) {
+    if(values == NULL || vecPtr == NULL || *vecPtr == NULL || count == 0) return;
+    vec_t* vecInfo = vec_getInfo(*vecPtr);
+    void* buff;
+    values = vec_unaliasValues(vecInfo, values, count, &buff);
+    if(values == NULL) return;
+    vecInfo = vec_pushBackN(vecInfo, values, count);
+    *vecPtr = vec_front(vecInfo);
+    if(buff != NULL) deallocator(buff);
+}
+
+// push count elements at the front of the vector, keeping their order
+static vec_t* vec_pushFrontN(vec_t* vec, const void* values, size_t count) {
+    if(vec->offset < count) {
+        // create room if needed
+        vec = vec_extendN(vec, count);
+        // shift everything to back of the array, same as vec_pushFront
+        size_t newOffset = vec->capacity - vec->size;
+        memmove(vec->baseArr + newOffset * vec->memSize, vec_front(vec), vec->size * vec->memSize);
+        vec_statAdd(vec, bytesRebased, vec->size * vec->memSize);
+        vec->offset = newOffset;
+    }
+    vec->offset -= count;
+    vec->size += count;
+    memcpy(vec_front(vec), values, count * vec->memSize);
+    memcpy(vec_front(vec) - sizeof(vec_t*), &vec, sizeof(vec_t*));
+    return vec_alignFront(vec);
+}
+
+void _vec_priv_pushFrontN(void** vecPtr, const void* values, size_t count) {
+    if(values == NULL || vecPtr == NULL || *vecPtr == NULL || count == 0) return;
+    vec_t* vecInfo = vec_getInfo(*vecPtr);
+    void* buff;
+    values = vec_unaliasValues(vecInfo, values, count, &buff);
+    if(values == NULL) return;
+    vecInfo = vec_pushFrontN(vecInfo, values, count);
+    *vecPtr = vec_front(vecInfo);
+    if(buff != NULL) deallocator(buff);
+}
+
+// resturn the size of the vector
+size_t vec_size(const void* vec) {
+    if(vec == NULL) return 0;
+    const vec_t* vecInfo = vec_getInfo(vec);
+    return vecInfo->size;
+}
+
+// free the vector
+void vec_free(void* vec) {
+    if(vec == NULL) return;
+    vec_t* arrInfo = vec_getInfo(vec);
+    // the array is allocated with the infos
+    vec_statAllocated(arrInfo, vec_allocSizeOf(arrInfo), 0);
+    arrInfo->alloc->free(arrInfo->alloc->ctx, arrInfo, vec_allocSizeOf(arrInfo));
+}
+
+// return the counters of the array, or the global ones if vec is NULL
+// all zeros if the library is compiled without VEC_STATS
+vec_stats_t vec_getStats(const void* vec) {
+#ifdef VEC_STATS
+    if(vec != NULL) return vec_getInfo(vec)->stats;
+    vec_stats_t stats;
+    stats.resizes = __atomic_load_n(&globalStats.resizes, __ATOMIC_RELAXED);
+    stats.bytesCopied = __atomic_load_n(&globalStats.bytesCopied, __ATOMIC_RELAXED);
+    stats.bytesMoved = __atomic_load_n(&globalStats.bytesMoved, __ATOMIC_RELAXED);
+    stats.bytesRebased = __atomic_load_n(&globalStats.bytesRebased, __ATOMIC_RELAXED);
+    stats.allocatedBytes = __atomic_load_n(&globalStats.allocatedBytes, __ATOMIC_RELAXED);
+    stats.peakBytes = __atomic_load_n(&globalStats.peakBytes, __ATOMIC_RELAXED);
+    stats.allocFailures = __atomic_load_n(&globalStats.allocFailures, __ATOMIC_RELAXED);
+    return stats;
+#else
+    vec_stats_t stats = { 0 };
+    return stats;
+#endif
+}
+
+// reset the global counters, the allocated bytes are kept and become the peak
+void vec_resetStats(void) {
+#ifdef VEC_STATS
+    __atomic_store_n(&globalStats.resizes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&globalStats.bytesCopied, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&globalStats.bytesMoved, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&globalStats.bytesRebased, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&globalStats.peakBytes, __atomic_load_n(&globalStats.allocatedBytes, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+    __atomic_store_n(&globalStats.allocFailures, 0, __ATOMIC_RELAXED);
+#endif
+}
+
+// print the counters of the array (or the global ones if vec is NULL) to stream
+void vec_dumpStats(const void* vec, FILE* stream) {
+#ifndef VEC_STATS
+    fprintf(stream, "vector stats: disabled, compile the library with VEC_STATS defined\n");
+#else
+    vec_stats_t stats = vec_getStats(vec);
+    fprintf(stream, "vector stats (%s):\n", vec == NULL ? "global" : "array");
+    fprintf(stream, "  resizes: %zu\n", stats.resizes);
+    fprintf(stream, "  bytes copied by resizes: %zu\n", stats.bytesCopied);
+    fprintf(stream, "  bytes moved in the array: %zu\n", stats.bytesMoved);
+    fprintf(stream, "  bytes moved by pushFront rebasing: %zu\n", stats.bytesRebased);
+    fprintf(stream, "  allocated bytes: %zu (peak %zu)\n", stats.allocatedBytes, stats.peakBytes);
+    if(vec == NULL) fprintf(stream, "  allocation failures: %zu\n", stats.allocFailures);
+#endif
+}
+
+// store the last element in buff and remove it from the vector
+// if buff is NULL, the element is just deleted
+static vec_t* vec_popBack(vec_t* vec, void* buff) {
+    if(vec->size == 0) return vec;
+    if(buff != NULL) memcpy(buff, vec_indexFromBack(vec, 1), vec->memSize);
+    vec->size--;
+    return vec_shrink(vec);
+}
+
+void _vec_priv_popBack(void** vecPtr, void* buff) {
+    if(vecPtr == NULL || *vecPtr == NULL) return;
+    vec_t* vecInfo = vec_getInfo(*vecPtr);
+    if(vecInfo->size == 0) return;
+    vecInfo = vec_popBack(vecInfo, buff);
+    *vecPtr = vec_front(vecInfo);
+}
+
+// store the first element in buff and remove it from the vector
+// if buff is NULL, the element is just deleted
+static vec_t* vec_popFront(vec_t* vec, void* buff) {
+    if(vec->size == 0) return vec;
+    if(buff != NULL) memcpy(buff, vec->baseArr + vec->offset * vec->memSize, vec->memSize);
+    vec->size--;
+    vec->offset++;
+    memcpy(vec_front(vec) - sizeof(vec_t*), &vec, sizeof(vec_t*));
+    return vec_shrink(vec_alignFront(vec));
+}
+
+void _vec_priv_popFront(void** vecPtr, void* buff) {
+    if(vecPtr == NULL || *vecPtr == NULL) return;
+    vec_t* vecInfo = vec_getInfo(*vecPtr);
+    if(vecInfo->size == 0) return;
+    vecInfo = vec_popFront(vecInfo, buff);
+    *vecPtr = vec_front(vecInfo);
+}
+
+// sort the vector using the given comparator
+void vec_sort(void* vec) {
+    if(vec == NULL) return;
+    vec_t* vecInfo = vec_getInfo(vec);
+    if(vecInfo->cmp == NULL) {
+        fprintf(stderr, "Error: vec_sort: no comparator set\n");
+        return;
+    }
+    qsort(vec_front(vecInfo), vecInfo->size, vecInfo->memSize, vecInfo->cmp);
+}
+
+// sort the vector using the comparator given as argument
+void vec_qsort(void* vec, int (*compar_fn) (const void *, const void *)) {
+    if(vec == NULL) return;
+    vec_t* vecInfo = vec_getInfo(vec);
+    qsort(vec_front(vecInfo), vecInfo->size, vecInfo->memSize, compar_fn);
+}
+
+// under this number of elements per thread, vec_sort_parallel and the parallel loops use less threads
+#define VEC_PARALLEL_MIN_CHUNK 4096
+// size of a cache line, the parts of the parallel loops start on a new one when possible
+#define VEC_CACHE_LINE 64
+
+// work given to each thread of the parallel sort
+typedef struct {
+    void* arr; // part to sort for the sort phase, first run for the merge phase
+    size_t n; // size of arr
+    const void* b; // second run for the merge phase
+    size_t nb; // size of b
+    void* out; // where the runs are merged
+    size_t outStart, outEnd; // part of the merged runs this thread is responsible for
+    size_t memSize;
+    int (*cmp)(const void*, const void*);
+    void (*sortFn)(void*, size_t);
+    void (*mergeFn)(const void*, size_t, const void*, size_t, void*);
+} vec_sortTask_t;
+
+// stable merge of a and b into out, using the comparator
+static void vec_mergeCmp(const void* a, size_t na, const void* b, size_t nb, void* out, size_t memSize, int (*cmp)(const void*, const void*)) {
+    size_t i = 0, j = 0;
+    while(i < na && j < nb) {
+        // on equality take from a to keep the merge stable
+        if(cmp(b + j * memSize, a + i * memSize) < 0) {
+            memcpy(out, b + j * memSize, memSize);
+            j++;
+        } else {
+            memcpy(out, a + i * memSize, memSize);
+            i++;
+        }
+        out += memSize;
+    }
+    memcpy(out, a + i * memSize, (na - i) * memSize);
+    out += (na - i) * memSize;
+    memcpy(out, b + j * memSize, (nb - j) * memSize);
+}
+
+// return how many elements of a are in the k first elements of the merge of a and b
+// binary search on the merge path, so each thread can find its part of the merge by itself
+static size_t vec_mergeCorank(const void* a, size_t na, const void* b, size_t nb, size_t k, size_t memSize, int (*cmp)(const void*, const void*)) {
+    size_t lo = k > nb ? k - nb : 0;
+    size_t hi = k < na ? k : na;
+    while(lo < hi) {
+        size_t i = (lo + hi) / 2;
+        size_t j = k - i;
+        // a[i] is in the k first elements if it is not greater than b[j - 1]
+        if(j > 0 && cmp(a + i * memSize, b + (j - 1) * memSize) <= 0) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+static void* vec_sortTask(void* arg) {
+    vec_sortTask_t* task = arg;
+    if(task->out == NULL) {
+        if(task->sortFn != NULL) {
+            task->sortFn(task->arr, task->n);
+        } else {
+            qsort(task->arr, task->n, task->memSize, task->cmp);
+        }
+        return NULL;
+    }
+    size_t memSize = task->memSize;
+    size_t i0 = vec_mergeCorank(task->arr, task->n, task->b, task->nb, task->outStart, memSize, task->cmp);
+    size_t i1 = vec_mergeCorank(task->arr, task->n, task->b, task->nb, task->outEnd, memSize, task->cmp);
+    size_t j0 = task->outStart - i0, j1 = task->outEnd - i1;
+    const void* a = task->arr + i0 * memSize;
+    const void* b = task->b + j0 * memSize;
+    void* out = task->out + task->outStart * memSize;
+    if(task->mergeFn != NULL) {
+        task->mergeFn(a, i1 - i0, b, j1 - j0, out);
+    } else {
+        vec_mergeCmp(a, i1 - i0, b, j1 - j0, out, memSize, task->cmp);
+    }
+    return NULL;
+}
+
+// run the tasks, one thread each, the calling thread run the first one
+static void vec_runTasks(vec_sortTask_t* tasks, size_t count) {
+    pthread_t threads[count];
+    size_t started = 1;
+    for(; started < count; started++) {
+        if(pthread_create(&threads[started], NULL, vec_sortTask, &tasks[started]) != 0) break;
+    }
+    vec_sortTask(&tasks[0]);
+    // if a thread could not be created, do its work here
+    for(size_t i = started; i < count; i++) {
+        vec_sortTask(&tasks[i]);
+    }
+    for(size_t i = 1; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+// sort the elements of the view with nthreads threads:
+// each thread sort a part of the array, then the parts are merged 2 by 2,
+// each merge being split between the threads
+// sortFn and mergeFn can be NULL, then qsort and a merge with cmp are used
+void _vec_priv_sortParallel(vec_view_t view, size_t nthreads, int (*cmp)(const void*, const void*),
+        void (*sortFn)(void*, size_t), void (*mergeFn)(const void*, size_t, const void*, size_t, void*)) {
+    if(view.data == NULL) return;
+    if(cmp == NULL) {
+        fprintf(stderr, "Error: vec_sort_parallel: no comparator set\n");
+        return;
+    }
+    size_t n = view.size, memSize = view.memSize;
+    // the merges are done 2 by 2, so use a power of 2 of threads,
+    // and don't give them too small parts
+    size_t threads = 1;
+    while(threads * 2 <= nthreads && threads * 2 * VEC_PARALLEL_MIN_CHUNK <= n) threads *= 2;
+    void* arr = view.data;
+    vec_sortTask_t tasks[threads];
+    size_t bounds[threads + 1];
+    for(size_t t = 0; t <= threads; t++) {
+        bounds[t] = n * t / threads;
+    }
+    for(size_t t = 0; t < threads; t++) {
+        tasks[t] = (vec_sortTask_t){
+            .arr = arr + bounds[t] * memSize, .n = bounds[t + 1] - bounds[t],
+            .memSize = memSize, .cmp = cmp, .sortFn = sortFn, .mergeFn = mergeFn
+        };
+    }
+    vec_runTasks(tasks, threads);
+    if(threads == 1) return;
+
+    // the view is inside its parent, so the room at the back of the parent can be used
+    void* scratch = _vec_priv_scratch(view.parent, n);
+    if(scratch == NULL) {
+        fprintf(stderr, "Error: vec_sort_parallel: no memory to merge, falling back to a single thread sort\n");
+        qsort(arr, n, memSize, cmp);
+        return;
+    }
+    void* src = arr;
+    void* dst = scratch;
+    // at each round, runs of width parts are merged 2 by 2, each merge by 2 * width threads
+    for(size_t width = 1; width < threads; width *= 2) {
+        for(size_t t = 0; t < threads; t++) {
+            size_t pair = t / (2 * width), part = t % (2 * width);
+            size_t start = bounds[pair * 2 * width];
+            size_t mid = bounds[pair * 2 * width + width];
+            size_t end = bounds[(pair + 1) * 2 * width];
+            tasks[t].arr = src + start * memSize;
+            tasks[t].n = mid - start;
+            tasks[t].b = src + mid * memSize;
+            tasks[t].nb = end - mid;
+            tasks[t].out = dst + start * memSize;
+            tasks[t].outStart = (end - start) * part / (2 * width);
+            tasks[t].outEnd = (end - start) * (part + 1) / (2 * width);
+        }
+        vec_runTasks(tasks, threads);
+        void* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    if(src != arr) memcpy(arr, src, n * memSize);
+    _vec_priv_scratchFree(view.parent, scratch);
+}
+
+// sort the vector using the comparator of the vector and nthreads threads
+void vec_sort_parallel(void* vec, size_t nthreads) {
+    if(vec == NULL) return;
+    vec_t* vecInfo = vec_getInfo(vec);
+    _vec_priv_sortParallel(vec_view(vec, 0, vecInfo->size), nthreads, vecInfo->cmp, NULL, NULL);
+}
+
+// sort the elements of the view using the given comparator and nthreads threads
+void vec_view_sort_parallel(vec_view_t view, size_t nthreads, int (*cmp)(const void*, const void*)) {
+    _vec_priv_sortParallel(view, nthreads, cmp, NULL, NULL);
+}
+
+// pool of threads waiting for parallel loops, the thread calling the loop run the first part,
+// and each worker run the part of its index
+// one loop run at a time, the others wait on runLock
+struct vec_threadPool_s {
+    pthread_mutex_t runLock;
+    pthread_mutex_t lock;
+    pthread_cond_t start; // signaled when a loop is posted or the pool is stopped
+    pthread_cond_t done; // signaled when the last worker finished its part
+    pthread_t* threads;
+    size_t nthreads; // number of workers
+    size_t generation; // incremented for each loop, so the workers know there is a new one
+    size_t pending; // workers that didn't finish the current loop
+    int stop;
+    // current loop
+    void (*fn)(void*, size_t, size_t, size_t);
+    void* ctx;
+    const size_t* bounds; // part i is [bounds[i], bounds[i + 1])
+    size_t parts;
+};
+
+typedef struct {
+    vec_threadPool_t* pool;
+    size_t index; // part run by the worker
+} vec_worker_t;
+
+// set while the thread run a part of a loop, a loop started from there is run serially:
+// the workers are all busy with the outer loop, and runLock is held by the thread that started it
+static _Thread_local int vecInParallelPart = 0;
+
+static void* vec_workerMain(void* arg) {
+    vec_worker_t* worker = arg;
+    vec_threadPool_t* pool = worker->pool;
+    size_t index = worker->index;
+    deallocator(worker);
+    size_t generation = 0;
+    pthread_mutex_lock(&pool->lock);
+    for(;;) {
+        while(!pool->stop && pool->generation == generation) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if(pool->stop) break;
+        generation = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+        if(index < pool->parts) {
+            vecInParallelPart = 1;
+            pool->fn(pool->ctx, pool->bounds[index], pool->bounds[index + 1], index);
+            vecInParallelPart = 0;
+        }
+        pthread_mutex_lock(&pool->lock);
+        if(--pool->pending == 0) pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+// create a pool of nthreads threads (counting the thread calling the loops), 0 for the number of cpus
+vec_threadPool_t* vec_threadPool_create(size_t nthreads) {
+    if(nthreads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = cpus > 0 ? cpus : 1;
+    }
+    vec_threadPool_t* pool = allocator(sizeof(vec_threadPool_t));
+    if(pool == NULL) {
+        fprintf(stderr, "vec_threadPool_create: malloc failed, requested size: %zu\n", sizeof(vec_threadPool_t));
+        return NULL;
+    }
+    pool->threads = allocator((nthreads - 1) * sizeof(pthread_t) + 1);
+    if(pool->threads == NULL) {
+        fprintf(stderr, "vec_threadPool_create: malloc failed, requested size: %zu\n", (nthreads - 1) * sizeof(pthread_t) + 1);
+        deallocator(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->runLock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->nthreads = 0;
+    pool->generation = 0;
+    pool->pending = 0;
+    pool->stop = 0;
+    pool->parts = 0;
+    // if a thread can't be created, the pool just has less workers
+    for(size_t i = 1; i < nthreads; i++) {
+        vec_worker_t* worker = allocator(sizeof(vec_worker_t));
+        if(worker == NULL) break;
+        *worker = (vec_worker_t){ pool, i };
+        if(pthread_create(&pool->threads[pool->nthreads], NULL, vec_workerMain, worker) != 0) {
+            deallocator(worker);
+            break;
+        }
+        pool->nthreads++;
+    }
+    return pool;
+}
+
+// stop the workers and free the pool
+void vec_threadPool_free(vec_threadPool_t* pool) {
+    if(pool == NULL) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for(size_t i = 0; i < pool->nthreads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_mutex_destroy(&pool->runLock);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+    deallocator(pool->threads);
+    deallocator(pool);
+}
+
+size_t vec_threadPool_size(const vec_threadPool_t* pool) {
+    if(pool == NULL) return 1;
+    return pool->nthreads + 1;
+}
+
+// split [0, n) in parts of at least VEC_PARALLEL_MIN_CHUNK elements, one per thread of the pool,
+// and call fn(ctx, start, end, part) on each part, part being the index of the part (< vec_threadPool_size())
+// the bounds of the parts are moved so that base + bound * memSize is on a cache line when possible,
+// so two threads don't write in the same cache line of base
+// a NULL pool, too few elements, or a loop started from a part of another one, run the loop in one part in the calling thread
+void _vec_priv_parallelFor(vec_threadPool_t* pool, size_t n, size_t memSize, const void* base,
+        void (*fn)(void*, size_t, size_t, size_t), void* ctx) {
+    size_t parts = n / VEC_PARALLEL_MIN_CHUNK;
+    if(parts > vec_threadPool_size(pool)) parts = vec_threadPool_size(pool);
+    if(parts <= 1 || vecInParallelPart) {
+        fn(ctx, 0, n, 0);
+        return;
+    }
+    size_t bounds[parts + 1];
+    bounds[0] = 0;
+    bounds[parts] = n;
+    for(size_t i = 1; i < parts; i++) {
+        size_t bound = n * i / parts;
+        size_t misalign = ((uintptr_t)base + bound * memSize) % VEC_CACHE_LINE;
+        if(misalign != 0 && (VEC_CACHE_LINE - misalign) % memSize == 0) {
+            bound += (VEC_CACHE_LINE - misalign) / memSize;
+        }
+        bounds[i] = bound;
+    }
+    pthread_mutex_lock(&pool->runLock);
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->bounds = bounds;
+    pool->parts = parts;
+    pool->pending = pool->nthreads;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    vecInParallelPart = 1;
+    fn(ctx, bounds[0], bounds[1], 0);
+    vecInParallelPart = 0;
+    pthread_mutex_lock(&pool->lock);
+    while(pool->pending > 0) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->runLock);
+}
+
+// return a new array containing the elements beetween start and end, end excluded
+void* _vec_priv_slice(void* vec, size_t start, size_t end) {
+    if(vec == NULL) return NULL;
+    vec_t* vecInfo = vec_getInfo(vec);
+    // if start is out of bounds return empty array
+    if(start >= vecInfo->size) return vec_create(vecInfo->memSize, 0);
+    // if end is out of bounds set it to the end of the array
+    if(end > vecInfo->size) end = vecInfo->size;
+    // just create a new array with the right size
+    void* newArr = vec_create(vecInfo->memSize, end - start);
+    // and copy the values
+    memcpy(newArr, vec_index(vecInfo, start), (end - start) * vecInfo->memSize);
+    return newArr;
+}
+
+// return a view of the elements beetween start and end, end excluded
+// like slice, out of bounds indexes are clamped
+vec_view_t vec_view(const void* vec, size_t start, size_t end) {
+    vec_view_t view = { NULL, 0, 0, vec };
+    if(vec == NULL) return view;
+    const vec_t* vecInfo = vec_getInfo(vec);
+    view.memSize = vecInfo->memSize;
+    if(end > vecInfo->size) end = vecInfo->size;
+    if(start > end) start = end;
+    view.data = vec_index(vecInfo, start);
+    view.size = end - start;
+    return view;
+}
+
+// pipeline on all the elements of the array
+vec_pipe_t vec_pipe(const void* vec, void* ctx) {
+    return vec_view_pipe(vec_view(vec, 0, vec_size(vec)), ctx);
+}
+
+vec_pipe_t vec_view_pipe(vec_view_t view, void* ctx) {
+    return (vec_pipe_t){ .data = view.data, .left = view.size, .skip = 0, .take = SIZE_MAX, .ctx = ctx };
+}
+
+void vec_pipe_skip(vec_pipe_t* pipe, size_t count) {
+    if(pipe == NULL) return;
+    pipe->skip = count > SIZE_MAX - pipe->skip ? SIZE_MAX : pipe->skip + count;
+}
+
+void vec_pipe_take(vec_pipe_t* pipe, size_t count) {
+    if(pipe == NULL) return;
+    if(count < pipe->take) pipe->take = count;
+}
+
+// return a view of the elements of the view beetween start and end, end excluded
+vec_view_t vec_view_sub(vec_view_t view, size_t start, size_t end) {
+    if(end > view.size) end = view.size;
+    if(start > end) start = end;
+    if(view.data != NULL) view.data += start * view.memSize;
+    view.size = end - start;
+    return view;
+}
+
+// return a new array containing the elements of the view
+void* vec_view_toVec(vec_view_t view) {
+    if(view.memSize == 0) return NULL;
+    void* newArr = vec_create(view.memSize, view.size);
+    if(newArr == NULL) return NULL;
+    memcpy(newArr, view.data, view.size * view.memSize);
+    return newArr;
+}
+
+// sort the elements of the view using the given comparator
+void vec_view_qsort(vec_view_t view, int (*compar_fn) (const void *, const void *)) {
+    if(view.data == NULL) return;
+    qsort(view.data, view.size, view.memSize, compar_fn);
+}
+
+// insert an element at the given index
+static vec_t* vec_insert(vec_t* vecInfo, size_t index, void* value) {
+    if(index > vecInfo->size) return vecInfo;
+    // if index is at the end, just pushBack
+    if(index >= vecInfo->size) {
+        return vec_pushBack(vecInfo, value);
+    }
+    // if at the front pushFront
+    if(index == 0) {
+        return vec_pushFront(vecInfo, value);
+    }
+    vecInfo = vec_extend(vecInfo);
+    // need memmove here because everything is moved over itself by one element
+
+    // case where less elements are at the left of the index and offset != 0
+    // (and the front can move by one element, see vec_alignStep)
+    if(index < vecInfo->size - index && vecInfo->offset > 0 && vec_alignStep(vecInfo) == 1) {
+        // move everything at the left of the index to the left by one element
+        // can access index -1 as offset is > 0
+        vec_memmove(vecInfo, vec_index(vecInfo, -1), vec_front(vecInfo), index * vecInfo->memSize);
+        vecInfo->offset--;
+        memcpy(vec_front(vecInfo) - sizeof(vec_t*), &vecInfo, sizeof(vec_t*));
+    } else { 
+        // move everything at the right of the index to the right by one element
+        vec_memmove(vecInfo, vec_index(vecInfo, index + 1), vec_index(vecInfo, index), (vecInfo->size - index) * vecInfo->memSize);
+    }
+    // insert the value
+    memcpy(vec_index(vecInfo, index), value, vecInfo->memSize);
+    vecInfo->size++;
+    return vecInfo;
+}
+
+void _vec_priv_insert(void** vecPtr, size_t index, void* value) {
+    if(vecPtr == NULL || *vecPtr == NULL) return;
+    vec_t* vecInfo = vec_getInfo(*vecPtr);
+    vecInfo = vec_insert(vecInfo, index, value);
+    *vecPtr = vec_front(vecInfo);
+}
+
+// insert count elements at the given index, moving the rest of the array only once
+static vec_t* vec_insertRange(vec_t* vecInfo, size_t index, const void* values, size_t count) {
+    if(index > vecInfo->size) return vecInfo;
+    // if index is at the end, just pushBack
+    if(index == vecInfo->size) {
+        return vec_pushBackN(vecInfo, values, count);
+    }
+    // if at the front pushFront
+    if(index == 0) {
+        return vec_pushFrontN(vecInfo, values, count);
+    }
+    // case where less elements are at the left of the index and there is enough room at the front
+    if(index < vecInfo->size - index && vecInfo->offset >= count && count % vec_alignStep(vecInfo) == 0) {
+        // move everything at the left of the index to the left by count elements
+        vec_memmove(vecInfo, vec_index(vecInfo, -count), vec_front(vecInfo), index * vecInfo->memSize);
+        vecInfo->offset -= count;
+        memcpy(vec_front(vecInfo) - sizeof(vec_t*), &vecInfo, sizeof(vec_t*));
+    } else {
+        vecInfo = vec_extendN(vecInfo, count);
+        // move everything at the right of the index to the right by count elements
+        vec_memmove(vecInfo, vec_index(vecInfo, index + count), vec_index(vecInfo, index), (vecInfo->size - index) * vecInfo->memSize);
+    }
+    memcpy(vec_index(vecInfo, index), values, count * vecInfo->memSize);
+    vecInfo->size += count;
+    return vecInfo;
+}
+
+void _vec_priv_insertRange(void** vecPtr, size_t index, const void* values, size_t count) {
+    if(values == NULL || vecPtr == NULL || *vecPtr == NULL || count == 0) return;
+    vec_t* vecInfo = vec_getInfo(*vecPtr);
+    void* buff;
+    values = vec_unaliasValues(vecInfo, values, count, &buff);
+    if(values == NULL) return;
+    vecInfo = vec_insertRange(vecInfo, index, values, count);
+    *vecPtr = vec_front(vecInfo);
+    if(buff != NULL) deallocator(buff);
+}
+
+void _vec_priv_remove(void** vecPtr, size_t index, void* buff) {
+    if(vecPtr == NULL || *vecPtr == NULL) return;
+    vec_t* vecInfo = vec_getInfo(*vecPtr);
+    if(index >= vecInfo->size) return;
+    if(buff != NULL) memcpy(buff, vec_index(vecInfo, index), vecInfo->memSize);
+    // need memmove here because everything is moved over itself by one element
+    vec_memmove(vecInfo, vec_index(vecInfo, index), vec_index(vecInfo, index + 1), (vecInfo->size - index - 1) * vecInfo->memSize);
+    vecInfo->size--;
+    vecInfo = vec_shrink(vecInfo);
+    *vecPtr = vec_front(vecInfo);
+}
+
+// remove the elements beetween start and end, end excluded
+// move the smallest side of the array over the removed elements, then shrink once
+static vec_t* vec_eraseRange(vec_t* vecInfo, size_t start, size_t end) {
+    size_t count = end - start;
+    if(start < vecInfo->size - end && count % vec_alignStep(vecInfo) == 0) {
+        // less elements before the range, move them to the right and increase offset
+        vec_memmove(vecInfo, vec_index(vecInfo, count), vec_front(vecInfo), start * vecInfo->memSize);
+        vecInfo->offset += count;
+        memcpy(vec_front(vecInfo) - sizeof(vec_t*), &vecInfo, sizeof(vec_t*));
+    } else {
+        vec_memmove(vecInfo, vec_index(vecInfo, start), vec_index(vecInfo, end), (vecInfo->size - end) * vecInfo->memSize);
+    }
+    vecInfo->size -= count;
+    return vec_shrink(vecInfo);
+}
+
+void _vec_priv_eraseRange(void** vecPtr, size_t start, size_t end) {
+    if(vecPtr == NULL || *vecPtr == NULL) return;
+    vec_t* vecInfo = vec_getInfo(*vecPtr);
+    // if end is out of bounds set it to the end of the array
+    if(end > vecInfo->size) end = vecInfo->size;
+    if(start >= end) return;
+    vecInfo = vec_eraseRange(vecInfo, start, end);
+    *vecPtr = vec_front(vecInfo);
+}
+
+// keep only the elements for which keep return true, in one pass
+// runs of kept elements are moved together, then the array is shrinked once
+size_t vec_retain(void* vecPtr, int (*keep)(const void*, void*), void* ctx) {
+    if(vecPtr == NULL || *(void**)vecPtr == NULL || keep == NULL) return 0;
+    vec_t* vecInfo = vec_getInfo(*(void**)vecPtr);
+    // keep is called once per element, the pending run of kept elements [runStart, i)
+    // is moved when a removed element or the end is reached
+    size_t write = 0, runStart = 0, size = vecInfo->size;
+    for(size_t i = 0; i <= size; i++) {
+        if(i < size && keep(vec_index(vecInfo, i), ctx)) continue;
+        if(runStart != write && i > runStart) {
+            vec_memmove(vecInfo, vec_index(vecInfo, write), vec_index(vecInfo, runStart), (i - runStart) * vecInfo->memSize);
+        }
+        write += i - runStart;
+        runStart = i + 1;
+    }
+    size_t removed = size - write;
+    if(removed > 0) {
+        vecInfo->size = write;
+        vecInfo = vec_shrink(vecInfo);
+        *(void**)vecPtr = vec_front(vecInfo);
+    }
+    return removed;
+}
+
+
+// swap the elements at the given indexes
+void vec_swap(void* vec, size_t index1, size_t index2) {
+    if(vec == NULL || index1 == index2) return;
+    vec_t* vecInfo = vec_getInfo(vec);
+    if(index1 >= vecInfo->size || index2 >= vecInfo->size) return;
+
+    // the two possibility here avoid the need of a temp buffer
+    // by writing the values directly to unused memory of the array
+    // see functions definitions for more details
+    if(vec_hasFrontRoom(vecInfo)) {
+        vec_swap_front(vecInfo, index1, index2);
+        return;
+    } else if(vecInfo->capacity > vecInfo->size) {
+        vec_swap_back(vecInfo, index1, index2);
+        return;
+    }
+
+    // maybe allocating the buffer to the stack could be an optimization
+
+    void* buff = allocator(vecInfo->memSize);
+    if(buff == NULL) {
+        fprintf(stderr, "vec_swap: buffer malloc failed, requested size: %zu\n", vecInfo->memSize);
+        return;
+    }
+    vec_swap_buff(vecInfo, index1, index2, buff);
+    deallocator(buff);
+}
+
+// remove all elements from the vector and set its size to 0
+void _vec_priv_clear(void** vecPtr) {
+    if(vecPtr == NULL || *vecPtr == NULL) return;
+    vec_t* vecInfo = vec_getInfo(*vecPtr);
+    // need to set size to 0 now because vec_resize copy the old array
+    vecInfo->size = 0;
+    // if the vector never shrink, keep the allocated memory
+    if(vecInfo->shrinkRatio == VEC_SHRINK_NEVER) {
+        vecInfo->offset = 0;
+    } else {
+        vecInfo = vec_resize(vecInfo, VEC_MIN_CAPACITY);
+    }
+    *vecPtr = vec_front(vecInfo);
+}
+
+
+// return a buffer big enough for count elements of the vector
+// use the unused space at the end of the array if it's big enough,
+// else allocate one, should be given back with _vec_priv_scratchFree()
+void* _vec_priv_scratch(const void* vec, size_t count) {
+    if(vec == NULL) return NULL;
+    const vec_t* vecInfo = vec_getInfo(vec);
+    if(vecInfo->capacity - vecInfo->offset - vecInfo->size >= count) {
+        return vec_back(vecInfo);
+    }
+    void* buff = allocator(count * vecInfo->memSize);
+    if(buff == NULL) {
+        fprintf(stderr, "_vec_priv_scratch: malloc failed, requested size: %zu\n", count * vecInfo->memSize);
+    }
+    return buff;
+}
+
+// free a buffer given by _vec_priv_scratch(), if it was allocated
+void _vec_priv_scratchFree(const void* vec, void* buff) {
+    if(vec == NULL || buff == NULL) return;
+    const vec_t* vecInfo = vec_getInfo(vec);
+    if(buff == vec_back(vecInfo)) return;
+    deallocator(buff);
+}
+
+void _vec_debug_print(void* vec, FILE* stream) {
+    if(vec == NULL) return;
+    vec_t* vecInfo = vec_getInfo(vec);
+    fprintf(stream, "size: %lu, offset: %lu, memSize: %lu, capacity: %lu\n", vecInfo->size, vecInfo->offset, vecInfo->memSize, vecInfo->capacity);
+    fprintf(stream, "effective memsize: %lu\n", vec_allocSizeOf(vecInfo));
+}
+
+// preallocate the vector to the given size, so newSize elements fit from the front of the array
+static vec_t* vec_reserve(vec_t* vec, size_t newSize) {
+    if(vec->offset + newSize <= vec->capacity) return vec;
+    if(newSize > vec->capacity) return vec_resize(vec, newSize);
+    // enough room, but it's at the front
+    vec_memmove(vec, vec->baseArr, vec_front(vec), vec->size * vec->memSize);
+    vec->offset = 0;
+    memcpy(vec->baseArr - sizeof(vec_t*), &vec, sizeof(vec_t*));
+    return vec;
+}
+
+// resize the array to exactly its size
+void vec_shrinkToFit(void* vecPtr) {
+    if(vecPtr == NULL || *(void**)vecPtr == NULL) return;
+    vec_t* vecInfo = vec_getInfo(*(void**)vecPtr);
+    if(vecInfo->capacity == vecInfo->size) return;
+    vecInfo = vec_resize(vecInfo, vecInfo->size);
+    *(void**)vecPtr = vec_front(vecInfo);
+}
+
+// return the number of elements the array can hold without resizing (counting the room at the front)
+size_t vec_capacity(const void* vec) {
+    if(vec == NULL) return 0;
+    return vec_getInfo(vec)->capacity;
+}
+
+// preallocates the vector to the given size and if resize is true set its size to the given size
+void vec_allocate(void* vecPtr, size_t newSize, int resize) {
+    if(vecPtr == NULL || *(void**)vecPtr == NULL) return;
+    vec_t* vecInfo = vec_getInfo(*(void**)vecPtr);
+    vecInfo = vec_reserve(vecInfo, newSize);
+    if(resize) vecInfo->size = newSize;
+    *(void**)vecPtr = vec_front(vecInfo);
+}
+
+// set the size of the array to size if it's smaller, without shrinking its memory,
+// so an output array keep its capacity for the next call
+void _vec_priv_truncate(void* vec, size_t size) {
+    if(vec == NULL) return;
+    vec_t* vecInfo = vec_getInfo(vec);
+    if(size < vecInfo->size) vecInfo->size = size;
+}
+
+// return the output array of the functions writing to a given array (parallel loops, set operations):
+// *outPtr resized to size if given, else a new array
+// NULL if the array can't be allocated
+void* _vec_priv_outputArray(void** outPtr, size_t memSize, size_t size) {
+    if(outPtr == NULL || *outPtr == NULL) {
+        void* out = vec_create(memSize, size);
+        if(outPtr != NULL) *outPtr = out;
+        return out;
+    }
+    vec_t* vecInfo = vec_getInfo(*outPtr);
+    // keep the memory of the array for the next calls
+    if(size < vecInfo->size) {
+        _vec_priv_truncate(*outPtr, size);
+        return *outPtr;
+    }
+    vecInfo = vec_reserve(vecInfo, size);
+    *outPtr = vec_front(vecInfo);
+    if(vecInfo->offset + size > vecInfo->capacity) return NULL;
+    vecInfo->size = size;
+    return *outPtr;
+}
+
+// reverse the vector
+void vec_reverse(void* vec) {
+    if(vec == NULL) return;
+    vec_t* vecInfo = vec_getInfo(vec);
+    // no need for memmove here as i is strictly inferior to j,
+    // so i always different from j
+    // so dest and src can't overlap
+
+    // the two possibility here avoid the need of a temp buffer
+    // by writing the values directly to the array
+    if(vec_hasFrontRoom(vecInfo)) {
+        for(size_t i = 0, j = vecInfo->size - 1; i < j; i++, j--) {
+            vec_swap_front(vecInfo, i, j);
+        }
+        return;
+    } else if(vecInfo->capacity > vecInfo->size) {
+        for(size_t i = 0, j = vecInfo->size - 1; i < j; i++, j--) {
+            vec_swap_back(vecInfo, i, j);
+        }
+        return;
+    }
+
+    // same as vec_swap, maybe allocating the buffer to the stack
+    void* buff = allocator(vecInfo->memSize);
+    if(buff == NULL) {
+        fprintf(stderr, "vec_reverse: buffer malloc failed, requested size: %zu\n", vecInfo->memSize);
+        return;
+    }
+    for(size_t i = 0, j = vecInfo->size - 1; i < j; i++, j--) {
+        vec_swap_buff(vecInfo, i, j, buff);
+    }
+    deallocator(buff);
+}
+
+// set theallocator function
+// realloc can't be used on the blocks of an other allocator, so it's disabled until a reallocator is set
+void vec_set_allocator(void* (*_allocator)(size_t)) {
+    vec_cache_trim();
+    allocator = _allocator;
+    reallocator = NULL;
+}
+
+// set the reallocator function
+void vec_set_reallocator(void* (*_reallocator)(void*, size_t)) {
+    reallocator = _reallocator;
+}
+
+// set the deallocator function
+void vec_set_deallocator(void (*_deallocator)(void*)) {
+    vec_cache_trim();
+    deallocator = _deallocator;
+    reallocator = NULL;
+}
+
+// set the limits of the caches of freed blocks, shared by all threads
+// the blocks bigger than the mapping threshold are never cached
+void vec_cache_setLimits(size_t maxBlocks, size_t maxBytes, size_t maxBlockSize) {
+    if(maxBlockSize >= VEC_MMAP_THRESHOLD) maxBlockSize = VEC_MMAP_THRESHOLD - 1;
+    __atomic_store_n(&vecCacheMaxBlockSize, maxBlockSize, __ATOMIC_RELAXED);
+    __atomic_store_n(&vecCacheMaxBytes, maxBytes, __ATOMIC_RELAXED);
+    __atomic_store_n(&vecCacheMaxBlocks, maxBlocks, __ATOMIC_RELAXED);
+    if(maxBlocks == 0) vec_cache_trim();
+}
+
+// give back all the blocks of the cache of the thread to the allocator of the library
+void vec_cache_trim(void) {
+    for(size_t i = 0; i < VEC_CACHE_CLASSES; i++) {
+        vec_cacheBlock_t* block = vecCache.lists[i];
+        while(block != NULL) {
+            vec_cacheBlock_t* next = block->next;
+            deallocator(block);
+            block = next;
+        }
+        vecCache.lists[i] = NULL;
+        vecCache.counts[i] = 0;
+    }
+    vecCache.bytes = 0;
+}
+
+// return the allocator of the array
+const vec_allocator_t* vec_getAllocator(const void* vec) {
+    if(vec == NULL) return NULL;
+    // the mappings are an implementation detail of the default allocator
+    return vec_blockAllocator(vec_getInfo(vec)->alloc, 0);
+}
+
+// set the comparator function for the vector
+void vec_setComparator(void* vec, int (*cmp)(const void*, const void*)) {
+    if(vec == NULL) return;
+    vec_t* vecInfo = vec_getInfo(vec);
+    vecInfo->cmp = cmp;
+}
+
+// set the growth and shrink policy of the vector
+void vec_setPolicy(void* vec, unsigned growthPercent, unsigned shrinkRatio) {
+    if(vec == NULL) return;
+    vec_t* vecInfo = vec_getInfo(vec);
+    // the array need to grow by at least one element
+    if(growthPercent <= 100) growthPercent = 101;
+    if(growthPercent > 10000) growthPercent = 10000;
+    vecInfo->growthPercent = growthPercent;
+    // a ratio of 1 would halve the array while it's still full
+    if(shrinkRatio != VEC_SHRINK_NEVER && shrinkRatio < 2) shrinkRatio = 2;
+    if(shrinkRatio > 255) shrinkRatio = 255;
+    vecInfo->shrinkRatio = shrinkRatio;
+}
+
+// return the index where the element should be inserted to keep the vector sorted
+static size_t vec_find_sorted_insertion(const vec_t* vecInfo, const void* value) {
+    if(vecInfo->cmp == NULL) {
+        fprintf(stderr, "vec_find_sorted_insertion: no compare function set\n");
+        return vecInfo->size;
+    }
+    size_t i = 0, j = vecInfo->size, m;
+    // don't search an equal value, but rather the insertion point
+    // loop until finding m such as
+    // the value at index m - 1 is smaller or equal to the value
+    // and the value at index m is greater to the value
+    // in case value is the smallest value, the insertion point is 0
+    // in case value is the largest value, the insertion point is vecInfo->size
+    // this is not that much more heavy work, as it will just always reach worst case scenario of a "normal" bsearch
+    while(i < j) {
+        m = (i + j) / 2;
+        if(vecInfo->cmp(vec_index(vecInfo, m), value) <= 0) {
+            i = m + 1;
+        } else {
+            j = m;
+        }
+    }
+    return i;
+}
+
+// insert the value at the right place to keep the array sorted
+// assume that the array is already sorted
+size_t _vec_priv_sortedInsert(void** vecPtr, void* value) {
+    if(vecPtr == NULL || *vecPtr == NULL) return 0;
+    vec_t* vecInfo = vec_getInfo(*vecPtr);
+    size_t i = vec_find_sorted_insertion(vecInfo, value);
+    vecInfo = vec_insert(vecInfo, i, value);
+    *vecPtr = vec_front(vecInfo);
+    return i;
+}
+
+// insert count values at the right place to keep the array sorted
+// the values are sorted, then merged with the array from the back in one pass
+static vec_t* vec_sortedInsertN(vec_t* vecInfo, const void* values, size_t count) {
+    size_t memSize = vecInfo->memSize;
+    vecInfo = vec_extendN(vecInfo, count);
+    // the sorted values need their own buffer, as the merge write over the room at the back of the array,
+    // use what is left at the back after that room if it's big enough
+    void* batch = vec_back(vecInfo) + count * memSize;
+    int allocated = 0;
+    if(vecInfo->capacity - vecInfo->offset - vecInfo->size < 2 * count) {
+        batch = allocator(count * memSize);
+        if(batch == NULL) {
+            fprintf(stderr, "vec_sortedInsertN: malloc failed, requested size: %zu\n", count * memSize);
+            return vecInfo;
+        }
+        allocated = 1;
+    }
+    memcpy(batch, values, count * memSize);
+    qsort(batch, count, memSize, vecInfo->cmp);
+    // merge from the back, so elements of the array are written after they are read
+    // on equality, the new value goes after, like vec_sortedInsert
+    size_t i = vecInfo->size, j = count;
+    while(j > 0) {
+        void* dst = vec_index(vecInfo, i + j - 1);
+        if(i > 0 && vecInfo->cmp(vec_index(vecInfo, i - 1), batch + (j - 1) * memSize) > 0) {
+            memcpy(dst, vec_index(vecInfo, i - 1), memSize);
+            i--;
+        } else {
+            memcpy(dst, batch + (j - 1) * memSize, memSize);
+            j--;
+        }
+    }
+    vecInfo->size += count;
+    if(allocated) deallocator(batch);
+    return vecInfo;
+}
+
+void _vec_priv_sortedInsertN(void** vecPtr, const void* values, size_t count) {
+    if(values == NULL || vecPtr == NULL || *vecPtr == NULL || count == 0) return;
+    vec_t* vecInfo = vec_getInfo(*vecPtr);
+    if(vecInfo->cmp == NULL) {
+        fprintf(stderr, "vec_sortedInsertN: no compare function set\n");
+        return;
+    }
+    vecInfo = vec_sortedInsertN(vecInfo, values, count);
+    *vecPtr = vec_front(vecInfo);
+}
+
+// return if the array is sorted, do a linear comparaison
+int vec_isSorted(const void* vec) {
+    if(vec == NULL) return 1;
+    const vec_t* vecInfo = vec_getInfo(vec);
+    if(vecInfo->cmp == NULL) {
+        fprintf(stderr, "vec_isSorted: no compare function set\n");
+        return 0;
+    }
+    for(size_t i = 1; i < vecInfo->size; i++) {
+        if(vecInfo->cmp(vec_index(vecInfo, i - 1), vec_index(vecInfo, i)) > 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// circular buffer, the elements wrap around the end of the array,
+// so push and pop at both ends never move the other elements
+// the allocated size is a power of 2, so the index can be wrapped with a mask
+struct vec_deque_s {
+    void* arr; // allocated array
+    size_t mask; // allocated size - 1
+    size_t head; // index in arr of the first element
+    size_t size; // number of elements
+    size_t memSize; // size of 1 element
+};
+
+#define vec_deque_capacity(dq) ((dq)->mask + 1)
+#define vec_deque_index(dq, i) ((dq)->arr + (((dq)->head + (i)) & (dq)->mask) * (dq)->memSize)
+
+// create a new deque with room for at least capacity elements of size memSize
+vec_deque_t* vec_deque_create(size_t memSize, size_t capacity) {
+    if(memSize == 0) return NULL;
+    vec_deque_t* dq = allocator(sizeof(vec_deque_t));
+    if(dq == NULL) {
+        fprintf(stderr, "vec_deque_create: malloc failed, requested size: %zu\n", sizeof(vec_deque_t));
+        return NULL;
+    }
+    size_t allocSize = SHIFT(LOG2(capacity ? capacity : 1) + 1);
+    dq->arr = allocator(allocSize * memSize);
+    if(dq->arr == NULL) {
+        fprintf(stderr, "vec_deque_create: malloc failed, requested size: %zu\n", allocSize * memSize);
+        deallocator(dq);
+        return NULL;
+    }
+    dq->mask = allocSize - 1;
+    dq->head = 0;
+    dq->size = 0;
+    dq->memSize = memSize;
+    return dq;
+}
+
+void vec_deque_free(vec_deque_t* dq) {
+    if(dq == NULL) return;
+    deallocator(dq->arr);
+    deallocator(dq);
+}
+
+size_t vec_deque_size(const vec_deque_t* dq) {
+    if(dq == NULL) return 0;
+    return dq->size;
+}
+
+// copy count elements starting at index start of the deque to buff, handling the wrap around
+static void vec_deque_copyOut(const vec_deque_t* dq, size_t start, void* buff, size_t count) {
+    size_t first = (dq->head + start) & dq->mask;
+    size_t firstPart = vec_deque_capacity(dq) - first;
+    if(firstPart > count) firstPart = count;
+    memcpy(buff, dq->arr + first * dq->memSize, firstPart * dq->memSize);
+    memcpy(buff + firstPart * dq->memSize, dq->arr, (count - firstPart) * dq->memSize);
+}
+
+// copy count elements from values to the deque starting at index start, handling the wrap around
+static void vec_deque_copyIn(vec_deque_t* dq, size_t start, const void* values, size_t count) {
+    size_t first = (dq->head + start) & dq->mask;
+    size_t firstPart = vec_deque_capacity(dq) - first;
+    if(firstPart > count) firstPart = count;
+    memcpy(dq->arr + first * dq->memSize, values, firstPart * dq->memSize);
+    memcpy(dq->arr, values + firstPart * dq->memSize, (count - firstPart) * dq->memSize);
+}
+
+// make room for count more elements, doubling the array as needed
+// the elements are unwrapped at the start of the new array
+static int vec_deque_reserve(vec_deque_t* dq, size_t count) {
+    if(dq->size + count <= vec_deque_capacity(dq)) return 1;
+    size_t allocSize = vec_deque_capacity(dq) * 2;
+    while(allocSize < dq->size + count) allocSize *= 2;
+    void* newArr = allocator(allocSize * dq->memSize);
+    if(newArr == NULL) {
+        fprintf(stderr, "vec_deque_reserve: malloc failed, requested size: %zu\n", allocSize * dq->memSize);
+        return 0;
+    }
+    vec_deque_copyOut(dq, 0, newArr, dq->size);
+    deallocator(dq->arr);
+    dq->arr = newArr;
+    dq->mask = allocSize - 1;
+    dq->head = 0;
+    return 1;
+}
+
+void _vec_priv_deque_pushBack(vec_deque_t* dq, const void* value) {
+    if(dq == NULL || value == NULL || !vec_deque_reserve(dq, 1)) return;
+    memcpy(vec_deque_index(dq, dq->size), value, dq->memSize);
+    dq->size++;
+}
+
+void _vec_priv_deque_pushFront(vec_deque_t* dq, const void* value) {
+    if(dq == NULL || value == NULL || !vec_deque_reserve(dq, 1)) return;
+    dq->head = (dq->head - 1) & dq->mask;
+    memcpy(dq->arr + dq->head * dq->memSize, value, dq->memSize);
+    dq->size++;
+}
+
+void _vec_priv_deque_popBack(vec_deque_t* dq, void* buff) {
+    if(dq == NULL || dq->size == 0) return;
+    dq->size--;
+    if(buff != NULL) memcpy(buff, vec_deque_index(dq, dq->size), dq->memSize);
+}
+
+void _vec_priv_deque_popFront(vec_deque_t* dq, void* buff) {
+    if(dq == NULL || dq->size == 0) return;
+    if(buff != NULL) memcpy(buff, dq->arr + dq->head * dq->memSize, dq->memSize);
+    dq->head = (dq->head + 1) & dq->mask;
+    dq->size--;
+}
+
+void _vec_priv_deque_pushBackN(vec_deque_t* dq, const void* values, size_t count) {
+    if(dq == NULL || values == NULL || !vec_deque_reserve(dq, count)) return;
+    vec_deque_copyIn(dq, dq->size, values, count);
+    dq->size += count;
+}
+
+// remove up to count elements from the front and copy them to buff (if not NULL)
+// return the number of elements removed
+size_t _vec_priv_deque_popFrontN(vec_deque_t* dq, void* buff, size_t count) {
+    if(dq == NULL) return 0;
+    if(count > dq->size) count = dq->size;
+    if(buff != NULL) vec_deque_copyOut(dq, 0, buff, count);
+    dq->head = (dq->head + count) & dq->mask;
+    dq->size -= count;
+    return count;
+}
+
+// return the address of the element at the given index, NULL if out of bounds
+// the address is valid until the next push
+void* _vec_priv_deque_at(const vec_deque_t* dq, size_t index) {
+    if(dq == NULL || index >= dq->size) return NULL;
+    return vec_deque_index(dq, index);
+}
+
+void vec_deque_clear(vec_deque_t* dq) {
+    if(dq == NULL) return;
+    dq->head = 0;
+    dq->size = 0;
+}
+
+// segmented array, the elements are stored in chunks of a fixed number of elements (a power of 2),
+// the chunks are never moved or reallocated, only the table of chunk pointers grows,
+// so the address of an element is valid until it's popped
+// one empty chunk is kept after the last used one, so push and pop around a chunk boundary don't allocate each time
+struct vec_segvec_s {
+    void** chunks; // table of chunks
+    size_t chunkCount; // number of allocated chunks
+    size_t tableSize; // number of slots in chunks
+    size_t shift; // log2 of the number of elements per chunk
+    size_t size; // number of elements
+    size_t memSize; // size of 1 element
+};
+
+// default size of a chunk, in bytes, when the number of elements per chunk isn't given
+#define VEC_SEGVEC_CHUNK_BYTES 4096
+
+#define vec_segvec_chunkMask(sv) (SHIFT((sv)->shift) - 1)
+#define vec_segvec_index(sv, i) ((sv)->chunks[(i) >> (sv)->shift] + ((i) & vec_segvec_chunkMask(sv)) * (sv)->memSize)
+
+// create a new segmented array of elements of size memSize,
+// with chunks of chunkSize elements (rounded up to a power of 2)
+vec_segvec_t* vec_segvec_create(size_t memSize, size_t chunkSize) {
+    if(memSize == 0) return NULL;
+    if(chunkSize == 0) chunkSize = memSize < VEC_SEGVEC_CHUNK_BYTES ? VEC_SEGVEC_CHUNK_BYTES / memSize : 1;
+    vec_segvec_t* sv = allocator(sizeof(vec_segvec_t));
+    if(sv == NULL) {
+        fprintf(stderr, "vec_segvec_create: malloc failed, requested size: %zu\n", sizeof(vec_segvec_t));
+        return NULL;
+    }
+    sv->chunks = NULL;
+    sv->chunkCount = 0;
+    sv->tableSize = 0;
+    sv->shift = chunkSize == 1 ? 0 : LOG2(chunkSize - 1) + 1;
+    sv->size = 0;
+    sv->memSize = memSize;
+    return sv;
+}
+
+void vec_segvec_free(vec_segvec_t* sv) {
+    if(sv == NULL) return;
+    for(size_t i = 0; i < sv->chunkCount; i++) {
+        deallocator(sv->chunks[i]);
+    }
+    deallocator(sv->chunks);
+    deallocator(sv);
+}
+
+size_t vec_segvec_size(const vec_segvec_t* sv) {
+    if(sv == NULL) return 0;
+    return sv->size;
+}
+
+size_t vec_segvec_chunkSize(const vec_segvec_t* sv) {
+    if(sv == NULL) return 0;
+    return SHIFT(sv->shift);
+}
+
+// allocate chunks until there is room for count more elements
+// only the table is reallocated (doubling), the chunks already allocated don't move
+static int vec_segvec_reserve(vec_segvec_t* sv, size_t count) {
+    size_t needed = (sv->size + count + vec_segvec_chunkMask(sv)) >> sv->shift;
+    if(needed <= sv->chunkCount) return 1;
+    if(needed > sv->tableSize) {
+        size_t tableSize = sv->tableSize ? sv->tableSize * 2 : VEC_MIN_CAPACITY;
+        while(tableSize < needed) tableSize *= 2;
+        void** chunks = allocator(tableSize * sizeof(void*));
+        if(chunks == NULL) {
+            fprintf(stderr, "vec_segvec_reserve: malloc failed, requested size: %zu\n", tableSize * sizeof(void*));
+            return 0;
+        }
+        if(sv->chunkCount) memcpy(chunks, sv->chunks, sv->chunkCount * sizeof(void*));
+        deallocator(sv->chunks);
+        sv->chunks = chunks;
+        sv->tableSize = tableSize;
+    }
+    size_t chunkBytes = SHIFT(sv->shift) * sv->memSize;
+    while(sv->chunkCount < needed) {
+        void* chunk = allocator(chunkBytes);
+        if(chunk == NULL) {
+            fprintf(stderr, "vec_segvec_reserve: malloc failed, requested size: %zu\n", chunkBytes);
+            return 0;
+        }
+        sv->chunks[sv->chunkCount++] = chunk;
+    }
+    return 1;
+}
+
+// free the chunks after the one following the last used chunk
+static void vec_segvec_trim(vec_segvec_t* sv) {
+    size_t used = (sv->size + vec_segvec_chunkMask(sv)) >> sv->shift;
+    while(sv->chunkCount > used + 1) {
+        deallocator(sv->chunks[--sv->chunkCount]);
+    }
+}
+
+// push the value at the end and return the address of the new element, NULL on failure
+void* _vec_priv_segvec_pushBack(vec_segvec_t* sv, const void* value) {
+    if(sv == NULL || value == NULL || !vec_segvec_reserve(sv, 1)) return NULL;
+    void* elem = vec_segvec_index(sv, sv->size);
+    memcpy(elem, value, sv->memSize);
+    sv->size++;
+    return elem;
+}
+
+void _vec_priv_segvec_popBack(vec_segvec_t* sv, void* buff) {
+    if(sv == NULL || sv->size == 0) return;
+    sv->size--;
+    if(buff != NULL) memcpy(buff, vec_segvec_index(sv, sv->size), sv->memSize);
+    vec_segvec_trim(sv);
+}
+
+// push count values at the end, copying them chunk by chunk
+void _vec_priv_segvec_pushBackN(vec_segvec_t* sv, const void* values, size_t count) {
+    if(sv == NULL || values == NULL || !vec_segvec_reserve(sv, count)) return;
+    while(count > 0) {
+        size_t room = SHIFT(sv->shift) - (sv->size & vec_segvec_chunkMask(sv));
+        size_t part = room < count ? room : count;
+        memcpy(vec_segvec_index(sv, sv->size), values, part * sv->memSize);
+        values += part * sv->memSize;
+        sv->size += part;
+        count -= part;
+    }
+}
+
+// return the address of the element at the given index, NULL if out of bounds
+// the address stay valid until the element is popped
+void* _vec_priv_segvec_at(const vec_segvec_t* sv, size_t index) {
+    if(sv == NULL || index >= sv->size) return NULL;
+    return vec_segvec_index(sv, index);
+}
+
+// return the first element of the chunk at the given index and set count to its number of elements,
+// return NULL (and set count to 0) if the chunk hold no elements
+void* _vec_priv_segvec_chunk(const vec_segvec_t* sv, size_t chunkIndex, size_t* count) {
+    size_t start = sv == NULL ? 0 : chunkIndex << sv->shift;
+    if(sv == NULL || chunkIndex >= sv->chunkCount || start >= sv->size) {
+        if(count != NULL) *count = 0;
+        return NULL;
+    }
+    if(count != NULL) {
+        size_t left = sv->size - start;
+        *count = left < SHIFT(sv->shift) ? left : SHIFT(sv->shift);
+    }
+    return sv->chunks[chunkIndex];
+}
+
+// remove all elements and free all the chunks but one
+void vec_segvec_clear(vec_segvec_t* sv) {
+    if(sv == NULL) return;
+    sv->size = 0;
+    vec_segvec_trim(sv);
+}
+
+// arena allocator, the allocations are taken at the end of the current block
+// when it's full, the next block is used (kept from before a reset) or a new one is allocated
+// the allocations are aligned like malloc
+#define VEC_ARENA_ALIGN _Alignof(long double)
+#define VEC_ARENA_ROUND(n) (((n) + VEC_ARENA_ALIGN - 1) & ~(VEC_ARENA_ALIGN - 1))
+
+typedef struct vec_arenaBlock_s {
+    struct vec_arenaBlock_s* next;
+    size_t size; // size of data
+    size_t used; // bytes used in data
+    long double data[]; // long double so data is aligned like the allocations
+} vec_arenaBlock_t;
+
+struct vec_arena_s {
+    vec_allocator_t allocator; // given to the arrays, ctx is the arena
+    vec_arenaBlock_t* first;
+    vec_arenaBlock_t* current;
+    size_t blockSize;
+};
+
+static void* vec_arenaAlloc(void* ctx, size_t size) {
+    vec_arena_t* arena = ctx;
+    size = VEC_ARENA_ROUND(size);
+    vec_arenaBlock_t* block = arena->current;
+    // the blocks after current are empty (kept from before a reset)
+    while(block != NULL && block->size - block->used < size) {
+        block = block->next;
+    }
+    if(block == NULL) {
+        size_t blockSize = size > arena->blockSize ? size : arena->blockSize;
+        block = allocator(sizeof(vec_arenaBlock_t) + blockSize);
+        if(block == NULL) {
+            fprintf(stderr, "vec_arenaAlloc: malloc failed, requested size: %zu\n", sizeof(vec_arenaBlock_t) + blockSize);
+            return NULL;
+        }
+        block->size = blockSize;
+        block->used = 0;
+        // insert the new block after the current one
+        if(arena->current == NULL) {
+            block->next = arena->first;
+            arena->first = block;
+        } else {
+            block->next = arena->current->next;
+            arena->current->next = block;
+        }
+    }
+    arena->current = block;
+    void* ptr = (char*)block->data + block->used;
+    block->used += size;
+    return ptr;
+}
+
+// only the last allocation can be given back
+static void vec_arenaFree(void* ctx, void* ptr, size_t size) {
+    vec_arena_t* arena = ctx;
+    vec_arenaBlock_t* block = arena->current;
+    size = VEC_ARENA_ROUND(size);
+    if(block != NULL && (char*)ptr + size == (char*)block->data + block->used) {
+        block->used -= size;
+    }
+}
+
+// the last allocation can grow in place if there is room in its block
+static void* vec_arenaRealloc(void* ctx, void* ptr, size_t oldSize, size_t newSize) {
+    vec_arena_t* arena = ctx;
+    vec_arenaBlock_t* block = arena->current;
+    oldSize = VEC_ARENA_ROUND(oldSize);
+    newSize = VEC_ARENA_ROUND(newSize);
+    if(block != NULL && (char*)ptr + oldSize == (char*)block->data + block->used
+        && block->used - oldSize + newSize <= block->size) {
+        block->used = block->used - oldSize + newSize;
+        return ptr;
+    }
+    void* newPtr = vec_arenaAlloc(ctx, newSize);
+    if(newPtr == NULL) return NULL;
+    memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+    return newPtr;
+}
+
+vec_arena_t* vec_arena_create(size_t blockSize) {
+    vec_arena_t* arena = allocator(sizeof(vec_arena_t));
+    if(arena == NULL) {
+        fprintf(stderr, "vec_arena_create: malloc failed, requested size: %zu\n", sizeof(vec_arena_t));
+        return NULL;
+    }
+    arena->allocator.alloc = vec_arenaAlloc;
+    arena->allocator.realloc = vec_arenaRealloc;
+    arena->allocator.free = vec_arenaFree;
+    arena->allocator.ctx = arena;
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->blockSize = VEC_ARENA_ROUND(blockSize ? blockSize : 1);
+    return arena;
+}
+
+const vec_allocator_t* vec_arena_allocator(vec_arena_t* arena) {
+    if(arena == NULL) return NULL;
+    return &arena->allocator;
+}
+
+void vec_arena_reset(vec_arena_t* arena) {
+    if(arena == NULL) return;
+    for(vec_arenaBlock_t* block = arena->first; block != NULL; block = block->next) {
+        block->used = 0;
+    }
+    arena->current = arena->first;
+}
+
+void vec_arena_free(vec_arena_t* arena) {
+    if(arena == NULL) return;
+    vec_arenaBlock_t* block = arena->first;
+    while(block != NULL) {
+        vec_arenaBlock_t* next = block->next;
+        deallocator(block);
+        block = next;
+    }
+    deallocator(arena);
+}
+
+// pool allocator, the size classes are the powers of 2 from 2^VEC_POOL_MIN_CLASS to 2^VEC_POOL_MAX_CLASS
+// the blocks of a class are cut in slabs of VEC_POOL_SLAB_SIZE bytes (or 1 block if it's bigger),
+// and the freed blocks are kept in a linked list per class, stored in the blocks themselves
+// bigger allocations are made directly with the allocator of the library
+#define VEC_POOL_MIN_CLASS 5
+#define VEC_POOL_MAX_CLASS 24
+#define VEC_POOL_SLAB_SIZE ((size_t)1 << 16)
+
+typedef struct vec_poolSlab_s {
+    struct vec_poolSlab_s* next;
+    long double data[];
+} vec_poolSlab_t;
+
+struct vec_pool_s {
+    vec_allocator_t allocator; // given to the arrays, ctx is the pool
+    void* freeLists[VEC_POOL_MAX_CLASS + 1]; // first free block of each class
+    vec_poolSlab_t* slabs; // all the slabs, to free them with the pool
+};
+
+// index of the smallest class that can hold size bytes
+static unsigned vec_poolClass(size_t size) {
+    if(size <= SHIFT(VEC_POOL_MIN_CLASS)) return VEC_POOL_MIN_CLASS;
+    return LOG2(size - 1) + 1;
+}
+
+static void* vec_poolAlloc(void* ctx, size_t size) {
+    vec_pool_t* pool = ctx;
+    unsigned class = vec_poolClass(size);
+    if(class > VEC_POOL_MAX_CLASS) return allocator(size);
+    if(pool->freeLists[class] == NULL) {
+        size_t blockSize = SHIFT(class);
+        size_t slabSize = blockSize > VEC_POOL_SLAB_SIZE ? blockSize : VEC_POOL_SLAB_SIZE;
+        vec_poolSlab_t* slab = allocator(sizeof(vec_poolSlab_t) + slabSize);
+        if(slab == NULL) {
+            fprintf(stderr, "vec_poolAlloc: malloc failed, requested size: %zu\n", sizeof(vec_poolSlab_t) + slabSize);
+            return NULL;
+        }
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        // chain the blocks of the slab in the free list, in address order
+        char* data = (char*)slab->data;
+        void* next = NULL;
+        for(size_t i = slabSize; i > 0; i -= blockSize) {
+            memcpy(data + i - blockSize, &next, sizeof(void*));
+            next = data + i - blockSize;
+        }
+        pool->freeLists[class] = next;
+    }
+    void* ptr = pool->freeLists[class];
+    memcpy(&pool->freeLists[class], ptr, sizeof(void*));
+    return ptr;
+}
+
+static void vec_poolFree(void* ctx, void* ptr, size_t size) {
+    vec_pool_t* pool = ctx;
+    unsigned class = vec_poolClass(size);
+    if(class > VEC_POOL_MAX_CLASS) {
+        deallocator(ptr);
+        return;
+    }
+    memcpy(ptr, &pool->freeLists[class], sizeof(void*));
+    pool->freeLists[class] = ptr;
+}
+
+// the block don't move if the new size is in the same class
+static void* vec_poolRealloc(void* ctx, void* ptr, size_t oldSize, size_t newSize) {
+    unsigned oldClass = vec_poolClass(oldSize);
+    if(oldClass <= VEC_POOL_MAX_CLASS && oldClass == vec_poolClass(newSize)) return ptr;
+    void* newPtr = vec_poolAlloc(ctx, newSize);
+    if(newPtr == NULL) return NULL;
+    memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+    vec_poolFree(ctx, ptr, oldSize);
+    return newPtr;
+}
+
+vec_pool_t* vec_pool_create(void) {
+    vec_pool_t* pool = allocator(sizeof(vec_pool_t));
+    if(pool == NULL) {
+        fprintf(stderr, "vec_pool_create: malloc failed, requested size: %zu\n", sizeof(vec_pool_t));
+        return NULL;
+    }
+    pool->allocator.alloc = vec_poolAlloc;
+    pool->allocator.realloc = vec_poolRealloc;
+    pool->allocator.free = vec_poolFree;
+    pool->allocator.ctx = pool;
+    memset(pool->freeLists, 0, sizeof(pool->freeLists));
+    pool->slabs = NULL;
+    return pool;
+}
+
+const vec_allocator_t* vec_pool_allocator(vec_pool_t* pool) {
+    if(pool == NULL) return NULL;
+    return &pool->allocator;
+}
+
+void vec_pool_free(vec_pool_t* pool) {
+    if(pool == NULL) return;
+    vec_poolSlab_t* slab = pool->slabs;
+    while(slab != NULL) {
+        vec_poolSlab_t* next = slab->next;
+        deallocator(slab);
+        slab = next;
+    }
+    deallocator(pool);
+}
+
+// hash functions for the keys of the hash maps (VEC_DEF_HASHMAP),
+// the map functions themselves are defined by the macro
+// FNV-1a, the hash maps mix the result again so the high bits are good enough
+uint64_t vec_hash_bytes(const void* data, size_t size) {
+    const unsigned char* bytes = data;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+uint64_t vec_hash_string(const char* str) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for(; *str; str++) {
+        hash = (hash ^ (unsigned char)*str) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// search and reduction kernels for arrays of int, float, double and int64_t
+// each have a scalar version, and SSE2 and AVX2 versions on x86,
+// the version is chosen on the first call depending on what the cpu support (see VEC_SIMD_KERNEL)
+
+static size_t vec_find_int_scalar(const int* arr, size_t n, int value) {
+    for(size_t i = 0; i < n; i++) {
+        if(arr[i] == value) return i;
+    }
+    return n;
+}
+
+static size_t vec_count_int_scalar(const int* arr, size_t n, int value) {
+    size_t count = 0;
+    for(size_t i = 0; i < n; i++) {
+        count += arr[i] == value;
+    }
+    return count;
+}
+
+static int vec_min_int_scalar(const int* arr, size_t n) {
+    int min = arr[0];
+    for(size_t i = 1; i < n; i++) {
+        if(arr[i] < min) min = arr[i];
+    }
+    return min;
+}
+
+static int vec_max_int_scalar(const int* arr, size_t n) {
+    int max = arr[0];
+    for(size_t i = 1; i < n; i++) {
+        if(arr[i] > max) max = arr[i];
+    }
+    return max;
+}
+
+static long long vec_sum_int_scalar(const int* arr, size_t n) {
+    long long sum = 0;
+    for(size_t i = 0; i < n; i++) {
+        sum += arr[i];
+    }
+    return sum;
+}
+
+static size_t vec_find_float_scalar(const float* arr, size_t n, float value) {
+    for(size_t i = 0; i < n; i++) {
+        if(arr[i] == value) return i;
+    }
+    return n;
+}
+
+static size_t vec_count_float_scalar(const float* arr, size_t n, float value) {
+    size_t count = 0;
+    for(size_t i = 0; i < n; i++) {
+        count += arr[i] == value;
+    }
+    return count;
+}
+
+static float vec_min_float_scalar(const float* arr, size_t n) {
+    float min = arr[0];
+    for(size_t i = 1; i < n; i++) {
+        if(arr[i] < min) min = arr[i];
+    }
+    return min;
+}
+
+static float vec_max_float_scalar(const float* arr, size_t n) {
+    float max = arr[0];
+    for(size_t i = 1; i < n; i++) {
+        if(arr[i] > max) max = arr[i];
+    }
+    return max;
+}
+
+static double vec_sum_float_scalar(const float* arr, size_t n) {
+    double sum = 0;
+    for(size_t i = 0; i < n; i++) {
+        sum += arr[i];
+    }
+    return sum;
+}
+
+// min and max share their SIMD kernels
+static int vec_minmax_int_scalar(const int* arr, size_t n, int max) {
+    return max ? vec_max_int_scalar(arr, n) : vec_min_int_scalar(arr, n);
+}
+
+static float vec_minmax_float_scalar(const float* arr, size_t n, int max) {
+    return max ? vec_max_float_scalar(arr, n) : vec_min_float_scalar(arr, n);
+}
+
+static size_t vec_find_double_scalar(const double* arr, size_t n, double value) {
+    for(size_t i = 0; i < n; i++) {
+        if(arr[i] == value) return i;
+    }
+    return n;
+}
+
+static size_t vec_count_double_scalar(const double* arr, size_t n, double value) {
+    size_t count = 0;
+    for(size_t i = 0; i < n; i++) {
+        count += arr[i] == value;
+    }
+    return count;
+}
+
+static double vec_minmax_double_scalar(const double* arr, size_t n, int max) {
+    double res = arr[0];
+    for(size_t i = 1; i < n; i++) {
+        if(max ? arr[i] > res : arr[i] < res) res = arr[i];
+    }
+    return res;
+}
+
+static double vec_sum_double_scalar(const double* arr, size_t n) {
+    double sum = 0;
+    for(size_t i = 0; i < n; i++) {
+        sum += arr[i];
+    }
+    return sum;
+}
+
+static size_t vec_find_int64_scalar(const int64_t* arr, size_t n, int64_t value) {
+    for(size_t i = 0; i < n; i++) {
+        if(arr[i] == value) return i;
+    }
+    return n;
+}
+
+static size_t vec_count_int64_scalar(const int64_t* arr, size_t n, int64_t value) {
+    size_t count = 0;
+    for(size_t i = 0; i < n; i++) {
+        count += arr[i] == value;
+    }
+    return count;
+}
+
+static int64_t vec_minmax_int64_scalar(const int64_t* arr, size_t n, int max) {
+    int64_t res = arr[0];
+    for(size_t i = 1; i < n; i++) {
+        if(max ? arr[i] > res : arr[i] < res) res = arr[i];
+    }
+    return res;
+}
+
+// the sums of int64 wrap around, done on unsigned to not overflow
+static int64_t vec_sum_int64_scalar(const int64_t* arr, size_t n) {
+    uint64_t sum = 0;
+    for(size_t i = 0; i < n; i++) {
+        sum += (uint64_t)arr[i];
+    }
+    return (int64_t)sum;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// counters of the count kernels are 32 bits per lane,
+// so they are flushed before they can overflow
+#define VEC_SIMD_COUNT_FLUSH ((size_t)1 << 30)
+
+__attribute__((target("sse2")))
+static size_t vec_find_int_sse2(const int* arr, size_t n, int value) {
+    __m128i v = _mm_set1_epi32(value);
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(arr + i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, v)));
+        if(mask) return i + __builtin_ctz(mask);
+    }
+    return i + vec_find_int_scalar(arr + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+static size_t vec_find_int_avx2(const int* arr, size_t n, int value) {
+    __m256i v = _mm256_set1_epi32(value);
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(arr + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, v)));
+        if(mask) return i + __builtin_ctz(mask);
+    }
+    return i + vec_find_int_scalar(arr + i, n - i, value);
+}
+
+__attribute__((target("sse2")))
+static size_t vec_count_int_sse2(const int* arr, size_t n, int value) {
+    __m128i v = _mm_set1_epi32(value);
+    size_t count = 0, i = 0;
+    while(i + 4 <= n) {
+        // equal lanes are -1, so subtracting the comparison count them
+        __m128i acc = _mm_setzero_si128();
+        size_t end = n - i > VEC_SIMD_COUNT_FLUSH ? i + VEC_SIMD_COUNT_FLUSH : n;
+        for(; i + 4 <= end; i += 4) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(arr + i));
+            acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(x, v));
+        }
+        unsigned lanes[4];
+        _mm_storeu_si128((__m128i*)lanes, acc);
+        count += (size_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    return count + vec_count_int_scalar(arr + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+static size_t vec_count_int_avx2(const int* arr, size_t n, int value) {
+    __m256i v = _mm256_set1_epi32(value);
+    size_t count = 0, i = 0;
+    while(i + 8 <= n) {
+        __m256i acc = _mm256_setzero_si256();
+        size_t end = n - i > VEC_SIMD_COUNT_FLUSH ? i + VEC_SIMD_COUNT_FLUSH : n;
+        for(; i + 8 <= end; i += 8) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)(arr + i));
+            acc = _mm256_sub_epi32(acc, _mm256_cmpeq_epi32(x, v));
+        }
+        unsigned lanes[8];
+        _mm256_storeu_si256((__m256i*)lanes, acc);
+        for(int l = 0; l < 8; l++) count += lanes[l];
+    }
+    return count + vec_count_int_scalar(arr + i, n - i, value);
+}
+
+// SSE2 has no min/max on 32 bits integers, select with a comparison
+__attribute__((target("sse2")))
+static int vec_minmax_int_sse2(const int* arr, size_t n, int max) {
+    if(n < 4) return max ? vec_max_int_scalar(arr, n) : vec_min_int_scalar(arr, n);
+    __m128i acc = _mm_loadu_si128((const __m128i*)arr);
+    size_t i = 4;
+    for(; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(arr + i));
+        __m128i take = max ? _mm_cmpgt_epi32(x, acc) : _mm_cmplt_epi32(x, acc);
+        acc = _mm_or_si128(_mm_and_si128(take, x), _mm_andnot_si128(take, acc));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    int res = max ? vec_max_int_scalar(lanes, 4) : vec_min_int_scalar(lanes, 4);
+    for(; i < n; i++) {
+        if(max ? arr[i] > res : arr[i] < res) res = arr[i];
+    }
+    return res;
+}
+
+__attribute__((target("avx2")))
+static int vec_minmax_int_avx2(const int* arr, size_t n, int max) {
+    if(n < 8) return max ? vec_max_int_scalar(arr, n) : vec_min_int_scalar(arr, n);
+    __m256i acc = _mm256_loadu_si256((const __m256i*)arr);
+    size_t i = 8;
+    if(max) {
+        for(; i + 8 <= n; i += 8) {
+            acc = _mm256_max_epi32(acc, _mm256_loadu_si256((const __m256i*)(arr + i)));
+        }
+    } else {
+        for(; i + 8 <= n; i += 8) {
+            acc = _mm256_min_epi32(acc, _mm256_loadu_si256((const __m256i*)(arr + i)));
+        }
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    int res = max ? vec_max_int_scalar(lanes, 8) : vec_min_int_scalar(lanes, 8);
+    for(; i < n; i++) {
+        if(max ? arr[i] > res : arr[i] < res) res = arr[i];
+    }
+    return res;
+}
+
+// the sums are done on 64 bits lanes so they don't overflow
+__attribute__((target("sse2")))
+static long long vec_sum_int_sse2(const int* arr, size_t n) {
+    __m128i acc = _mm_setzero_si128();
+    __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(arr + i));
+        // sign extend to 64 bits by interleaving with the sign
+        __m128i sign = _mm_cmpgt_epi32(zero, x);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(x, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(x, sign));
+    }
+    long long lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    return lanes[0] + lanes[1] + vec_sum_int_scalar(arr + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static long long vec_sum_int_avx2(const int* arr, size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(arr + i));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + vec_sum_int_scalar(arr + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static size_t vec_find_float_sse2(const float* arr, size_t n, float value) {
+    __m128 v = _mm_set1_ps(value);
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(arr + i), v));
+        if(mask) return i + __builtin_ctz(mask);
+    }
+    return i + vec_find_float_scalar(arr + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+static size_t vec_find_float_avx2(const float* arr, size_t n, float value) {
+    __m256 v = _mm256_set1_ps(value);
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(arr + i), v, _CMP_EQ_OQ));
+        if(mask) return i + __builtin_ctz(mask);
+    }
+    return i + vec_find_float_scalar(arr + i, n - i, value);
+}
+
+__attribute__((target("sse2")))
+static size_t vec_count_float_sse2(const float* arr, size_t n, float value) {
+    __m128 v = _mm_set1_ps(value);
+    size_t count = 0, i = 0;
+    while(i + 4 <= n) {
+        __m128i acc = _mm_setzero_si128();
+        size_t end = n - i > VEC_SIMD_COUNT_FLUSH ? i + VEC_SIMD_COUNT_FLUSH : n;
+        for(; i + 4 <= end; i += 4) {
+            acc = _mm_sub_epi32(acc, _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(arr + i), v)));
+        }
+        unsigned lanes[4];
+        _mm_storeu_si128((__m128i*)lanes, acc);
+        count += (size_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    return count + vec_count_float_scalar(arr + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+static size_t vec_count_float_avx2(const float* arr, size_t n, float value) {
+    __m256 v = _mm256_set1_ps(value);
+    size_t count = 0, i = 0;
+    while(i + 8 <= n) {
+        __m256i acc = _mm256_setzero_si256();
+        size_t end = n - i > VEC_SIMD_COUNT_FLUSH ? i + VEC_SIMD_COUNT_FLUSH : n;
+        for(; i + 8 <= end; i += 8) {
+            __m256 mask = _mm256_cmp_ps(_mm256_loadu_ps(arr + i), v, _CMP_EQ_OQ);
+            acc = _mm256_sub_epi32(acc, _mm256_castps_si256(mask));
+        }
+        unsigned lanes[8];
+        _mm256_storeu_si256((__m256i*)lanes, acc);
+        for(int l = 0; l < 8; l++) count += lanes[l];
+    }
+    return count + vec_count_float_scalar(arr + i, n - i, value);
+}
+
+__attribute__((target("sse2")))
+static float vec_minmax_float_sse2(const float* arr, size_t n, int max) {
+    if(n < 4) return max ? vec_max_float_scalar(arr, n) : vec_min_float_scalar(arr, n);
+    __m128 acc = _mm_loadu_ps(arr);
+    size_t i = 4;
+    if(max) {
+        for(; i + 4 <= n; i += 4) acc = _mm_max_ps(acc, _mm_loadu_ps(arr + i));
+    } else {
+        for(; i + 4 <= n; i += 4) acc = _mm_min_ps(acc, _mm_loadu_ps(arr + i));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    float res = max ? vec_max_float_scalar(lanes, 4) : vec_min_float_scalar(lanes, 4);
+    for(; i < n; i++) {
+        if(max ? arr[i] > res : arr[i] < res) res = arr[i];
+    }
+    return res;
+}
+
+__attribute__((target("avx2")))
+static float vec_minmax_float_avx2(const float* arr, size_t n, int max) {
+    if(n < 8) return max ? vec_max_float_scalar(arr, n) : vec_min_float_scalar(arr, n);
+    __m256 acc = _mm256_loadu_ps(arr);
+    size_t i = 8;
+    if(max) {
+        for(; i + 8 <= n; i += 8) acc = _mm256_max_ps(acc, _mm256_loadu_ps(arr + i));
+    } else {
+        for(; i + 8 <= n; i += 8) acc = _mm256_min_ps(acc, _mm256_loadu_ps(arr + i));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    float res = max ? vec_max_float_scalar(lanes, 8) : vec_min_float_scalar(lanes, 8);
+    for(; i < n; i++) {
+        if(max ? arr[i] > res : arr[i] < res) res = arr[i];
+    }
+    return res;
+}
+
+// the sums of floats are done on doubles, to not lose too much precision on big arrays
+__attribute__((target("sse2")))
+static double vec_sum_float_sse2(const float* arr, size_t n) {
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(arr + i);
+        acc = _mm_add_pd(acc, _mm_cvtps_pd(x));
+        acc = _mm_add_pd(acc, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+    return lanes[0] + lanes[1] + vec_sum_float_scalar(arr + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static double vec_sum_float_avx2(const float* arr, size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm_loadu_ps(arr + i)));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + vec_sum_float_scalar(arr + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static size_t vec_find_double_sse2(const double* arr, size_t n, double value) {
+    __m128d v = _mm_set1_pd(value);
+    size_t i = 0;
+    for(; i + 2 <= n; i += 2) {
+        int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(arr + i), v));
+        if(mask) return i + __builtin_ctz(mask);
+    }
+    return i + vec_find_double_scalar(arr + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+static size_t vec_find_double_avx2(const double* arr, size_t n, double value) {
+    __m256d v = _mm256_set1_pd(value);
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(arr + i), v, _CMP_EQ_OQ));
+        if(mask) return i + __builtin_ctz(mask);
+    }
+    return i + vec_find_double_scalar(arr + i, n - i, value);
+}
+
+// the counters of doubles and int64 are 64 bits per lane, they can't overflow
+__attribute__((target("sse2")))
+static size_t vec_count_double_sse2(const double* arr, size_t n, double value) {
+    __m128d v = _mm_set1_pd(value);
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for(; i + 2 <= n; i += 2) {
+        acc = _mm_sub_epi64(acc, _mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(arr + i), v)));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    return lanes[0] + lanes[1] + vec_count_double_scalar(arr + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+static size_t vec_count_double_avx2(const double* arr, size_t n, double value) {
+    __m256d v = _mm256_set1_pd(value);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m256d mask = _mm256_cmp_pd(_mm256_loadu_pd(arr + i), v, _CMP_EQ_OQ);
+        acc = _mm256_sub_epi64(acc, _mm256_castpd_si256(mask));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + vec_count_double_scalar(arr + i, n - i, value);
+}
+
+__attribute__((target("sse2")))
+static double vec_minmax_double_sse2(const double* arr, size_t n, int max) {
+    if(n < 2) return vec_minmax_double_scalar(arr, n, max);
+    __m128d acc = _mm_loadu_pd(arr);
+    size_t i = 2;
+    if(max) {
+        for(; i + 2 <= n; i += 2) acc = _mm_max_pd(acc, _mm_loadu_pd(arr + i));
+    } else {
+        for(; i + 2 <= n; i += 2) acc = _mm_min_pd(acc, _mm_loadu_pd(arr + i));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+    double res = vec_minmax_double_scalar(lanes, 2, max);
+    for(; i < n; i++) {
+        if(max ? arr[i] > res : arr[i] < res) res = arr[i];
+    }
+    return res;
+}
+
+__attribute__((target("avx2")))
+static double vec_minmax_double_avx2(const double* arr, size_t n, int max) {
+    if(n < 4) return vec_minmax_double_scalar(arr, n, max);
+    __m256d acc = _mm256_loadu_pd(arr);
+    size_t i = 4;
+    if(max) {
+        for(; i + 4 <= n; i += 4) acc = _mm256_max_pd(acc, _mm256_loadu_pd(arr + i));
+    } else {
+        for(; i + 4 <= n; i += 4) acc = _mm256_min_pd(acc, _mm256_loadu_pd(arr + i));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    double res = vec_minmax_double_scalar(lanes, 4, max);
+    for(; i < n; i++) {
+        if(max ? arr[i] > res : arr[i] < res) res = arr[i];
+    }
+    return res;
+}
+
+__attribute__((target("sse2")))
+static double vec_sum_double_sse2(const double* arr, size_t n) {
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for(; i + 2 <= n; i += 2) acc = _mm_add_pd(acc, _mm_loadu_pd(arr + i));
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+    return lanes[0] + lanes[1] + vec_sum_double_scalar(arr + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static double vec_sum_double_avx2(const double* arr, size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) acc = _mm256_add_pd(acc, _mm256_loadu_pd(arr + i));
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + vec_sum_double_scalar(arr + i, n - i);
+}
+
+// SSE2 has no 64 bits comparison, both 32 bits halves need to be equal
+__attribute__((target("sse2")))
+static __m128i vec_cmpeq_int64_sse2(__m128i a, __m128i b) {
+    __m128i eq = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+__attribute__((target("sse2")))
+static size_t vec_find_int64_sse2(const int64_t* arr, size_t n, int64_t value) {
+    __m128i v = _mm_set1_epi64x(value);
+    size_t i = 0;
+    for(; i + 2 <= n; i += 2) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(arr + i));
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(vec_cmpeq_int64_sse2(x, v)));
+        if(mask) return i + __builtin_ctz(mask);
+    }
+    return i + vec_find_int64_scalar(arr + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+static size_t vec_find_int64_avx2(const int64_t* arr, size_t n, int64_t value) {
+    __m256i v = _mm256_set1_epi64x(value);
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(arr + i));
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(x, v)));
+        if(mask) return i + __builtin_ctz(mask);
+    }
+    return i + vec_find_int64_scalar(arr + i, n - i, value);
+}
+
+__attribute__((target("sse2")))
+static size_t vec_count_int64_sse2(const int64_t* arr, size_t n, int64_t value) {
+    __m128i v = _mm_set1_epi64x(value);
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for(; i + 2 <= n; i += 2) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(arr + i));
+        acc = _mm_sub_epi64(acc, vec_cmpeq_int64_sse2(x, v));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    return lanes[0] + lanes[1] + vec_count_int64_scalar(arr + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+static size_t vec_count_int64_avx2(const int64_t* arr, size_t n, int64_t value) {
+    __m256i v = _mm256_set1_epi64x(value);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(arr + i));
+        acc = _mm256_sub_epi64(acc, _mm256_cmpeq_epi64(x, v));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + vec_count_int64_scalar(arr + i, n - i, value);
+}
+
+// no 64 bits greater than before SSE4.2, so the SSE2 version is the scalar one
+#define vec_minmax_int64_sse2 vec_minmax_int64_scalar
+
+__attribute__((target("avx2")))
+static int64_t vec_minmax_int64_avx2(const int64_t* arr, size_t n, int max) {
+    if(n < 4) return vec_minmax_int64_scalar(arr, n, max);
+    __m256i acc = _mm256_loadu_si256((const __m256i*)arr);
+    size_t i = 4;
+    for(; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(arr + i));
+        __m256i take = max ? _mm256_cmpgt_epi64(x, acc) : _mm256_cmpgt_epi64(acc, x);
+        acc = _mm256_blendv_epi8(acc, x, take);
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    int64_t res = vec_minmax_int64_scalar(lanes, 4, max);
+    for(; i < n; i++) {
+        if(max ? arr[i] > res : arr[i] < res) res = arr[i];
+    }
+    return res;
+}
+
+// the lanes wrap around like the scalar version
+__attribute__((target("sse2")))
+static int64_t vec_sum_int64_sse2(const int64_t* arr, size_t n) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for(; i + 2 <= n; i += 2) acc = _mm_add_epi64(acc, _mm_loadu_si128((const __m128i*)(arr + i)));
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    return (int64_t)(lanes[0] + lanes[1] + (uint64_t)vec_sum_int64_scalar(arr + i, n - i));
+}
+
+__attribute__((target("avx2")))
+static int64_t vec_sum_int64_avx2(const int64_t* arr, size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) acc = _mm256_add_epi64(acc, _mm256_loadu_si256((const __m256i*)(arr + i)));
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    return (int64_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3] + (uint64_t)vec_sum_int64_scalar(arr + i, n - i));
+}
+
+// best version of a kernel for the cpu
+#define vec_simdSelect(name) \
+    (__builtin_cpu_supports("avx2") ? name##_avx2 : __builtin_cpu_supports("sse2") ? name##_sse2 : name##_scalar)
+
+#else
+
+#define vec_simdSelect(name) name##_scalar
+
+#endif
+
+// define the pointer to the version of a kernel used by the library, name##_impl,
+// it start on a resolver that choose the version on the first call, store it, and forward the call to it,
+// so the cpu is checked only once. threads calling it at the same time store the same version
+#define VEC_SIMD_KERNEL(ret, name, params, args) \
+    static ret name##_resolve params; \
+    static ret (*name##_impl) params = name##_resolve; \
+    static ret name##_resolve params { \
+        ret (*impl) params = vec_simdSelect(name); \
+        __atomic_store_n(&name##_impl, impl, __ATOMIC_RELAXED); \
+        return impl args; \
+    }
+#define vec_simdCall(name) __atomic_load_n(&name##_impl, __ATOMIC_RELAXED)
+
+VEC_SIMD_KERNEL(size_t, vec_find_int, (const int* arr, size_t n, int value), (arr, n, value))
+VEC_SIMD_KERNEL(size_t, vec_count_int, (const int* arr, size_t n, int value), (arr, n, value))
+VEC_SIMD_KERNEL(int, vec_minmax_int, (const int* arr, size_t n, int max), (arr, n, max))
+VEC_SIMD_KERNEL(long long, vec_sum_int, (const int* arr, size_t n), (arr, n))
+VEC_SIMD_KERNEL(size_t, vec_find_float, (const float* arr, size_t n, float value), (arr, n, value))
+VEC_SIMD_KERNEL(size_t, vec_count_float, (const float* arr, size_t n, float value), (arr, n, value))
+VEC_SIMD_KERNEL(float, vec_minmax_float, (const float* arr, size_t n, int max), (arr, n, max))
+VEC_SIMD_KERNEL(double, vec_sum_float, (const float* arr, size_t n), (arr, n))
+VEC_SIMD_KERNEL(size_t, vec_find_double, (const double* arr, size_t n, double value), (arr, n, value))
+VEC_SIMD_KERNEL(size_t, vec_count_double, (const double* arr, size_t n, double value), (arr, n, value))
+VEC_SIMD_KERNEL(double, vec_minmax_double, (const double* arr, size_t n, int max), (arr, n, max))
+VEC_SIMD_KERNEL(double, vec_sum_double, (const double* arr, size_t n), (arr, n))
+VEC_SIMD_KERNEL(size_t, vec_find_int64, (const int64_t* arr, size_t n, int64_t value), (arr, n, value))
+VEC_SIMD_KERNEL(size_t, vec_count_int64, (const int64_t* arr, size_t n, int64_t value), (arr, n, value))
+VEC_SIMD_KERNEL(int64_t, vec_minmax_int64, (const int64_t* arr, size_t n, int max), (arr, n, max))
+VEC_SIMD_KERNEL(int64_t, vec_sum_int64, (const int64_t* arr, size_t n), (arr, n))
+
+size_t _vec_priv_find_int(const int* arr, size_t n, int value) {
+    return vec_simdCall(vec_find_int)(arr, n, value);
+}
+
+size_t _vec_priv_count_int(const int* arr, size_t n, int value) {
+    return vec_simdCall(vec_count_int)(arr, n, value);
+}
+
+int _vec_priv_min_int(const int* arr, size_t n) {
+    if(n == 0) return 0;
+    return vec_simdCall(vec_minmax_int)(arr, n, 0);
+}
+
+int _vec_priv_max_int(const int* arr, size_t n) {
+    if(n == 0) return 0;
+    return vec_simdCall(vec_minmax_int)(arr, n, 1);
+}
+
+long long _vec_priv_sum_int(const int* arr, size_t n) {
+    return vec_simdCall(vec_sum_int)(arr, n);
+}
+
+size_t _vec_priv_find_float(const float* arr, size_t n, float value) {
+    return vec_simdCall(vec_find_float)(arr, n, value);
+}
+
+size_t _vec_priv_count_float(const float* arr, size_t n, float value) {
+    return vec_simdCall(vec_count_float)(arr, n, value);
+}
+
+float _vec_priv_min_float(const float* arr, size_t n) {
+    if(n == 0) return 0;
+    return vec_simdCall(vec_minmax_float)(arr, n, 0);
+}
+
+float _vec_priv_max_float(const float* arr, size_t n) {
+    if(n == 0) return 0;
+    return vec_simdCall(vec_minmax_float)(arr, n, 1);
+}
+
+double _vec_priv_sum_float(const float* arr, size_t n) {
+    return vec_simdCall(vec_sum_float)(arr, n);
+}
+
+size_t _vec_priv_find_double(const double* arr, size_t n, double value) {
+    return vec_simdCall(vec_find_double)(arr, n, value);
+}
+
+size_t _vec_priv_count_double(const double* arr, size_t n, double value) {
+    return vec_simdCall(vec_count_double)(arr, n, value);
+}
+
+double _vec_priv_min_double(const double* arr, size_t n) {
+    if(n == 0) return 0;
+    return vec_simdCall(vec_minmax_double)(arr, n, 0);
+}
+
+double _vec_priv_max_double(const double* arr, size_t n) {
+    if(n == 0) return 0;
+    return vec_simdCall(vec_minmax_double)(arr, n, 1);
+}
+
+double _vec_priv_sum_double(const double* arr, size_t n) {
+    return vec_simdCall(vec_sum_double)(arr, n);
+}
+
+size_t _vec_priv_find_int64(const int64_t* arr, size_t n, int64_t value) {
+    return vec_simdCall(vec_find_int64)(arr, n, value);
+}
+
+size_t _vec_priv_count_int64(const int64_t* arr, size_t n, int64_t value) {
+    return vec_simdCall(vec_count_int64)(arr, n, value);
+}
+
+int64_t _vec_priv_min_int64(const int64_t* arr, size_t n) {
+    if(n == 0) return 0;
+    return vec_simdCall(vec_minmax_int64)(arr, n, 0);
+}
+
+int64_t _vec_priv_max_int64(const int64_t* arr, size_t n) {
+    if(n == 0) return 0;
+    return vec_simdCall(vec_minmax_int64)(arr, n, 1);
+}
+
+int64_t _vec_priv_sum_int64(const int64_t* arr, size_t n) {
+    return vec_simdCall(vec_sum_int64)(arr, n);
+}
+
+/**
+ * 
+ * TLDR: I'm doing black magic in C, and it work better than it should.
+ * 
+ * 
+ * I will try to explain the inner workings of this code, which is pure black magic,
+ * and will surely make some people mad.
+ * (first thing, the struct vec_t contain the infos about the vector.)
+ * When I tried to design this lib for the first time, 
+ * I gave back the struct to the user and he add to access an array in the struct
+ * But it was not practical, and I wanted to just do vec[i] = x, and not vec.arr[i] = x
+ * so I gave back the array to the user and he can access it with the [] operator.
+ * but now, how do I access the info when the user want to push item or the size?
+ * well at first I've done the most stupid things that came to my mind, 
+ * I just created an array that store the infos of all the current vec, 
+ * and do a bsearch when I need to access the info of a vec.
+ * so as you can imagine, I need to sort the array everytime the vec address change,
+ * so most of the workload was sorting and searching in an array.
+ * but now, I use some address pointers tricks to make it more efficient.
+ * when I allocate the memory for the array, I also allocate the size of an address to the struct vec_t
+ * so instead of allocating size * memSize, I allocate size * memSize + sizeof(vec_t*)
+ * and I give back the address, but shifted of sizeof(vec_t*)
+ * so when the user use functions on the vector, I just shift it back to retrieve the address
+ * (see macro vec_getInfo(vec))
+ * the struct itself is allocated in the same block, just before that address,
+ * so creating a vector is one allocation, and the infos are close to the data in memory.
+ * the downside is that the struct move when the array is resized,
+ * so every internal function that can resize return the new address of the struct.
+ * I don't know if its the best, if it's really safe, but it works, and it's fast, 
+ * and it's very convenient, for the user and for me.
+ * 
+ * user could use the "privates" functions of the library, but the prefered way is to define wrapper functions.
+ * macros to define them are defines in the header file.
+ * most of the functions are inlined so it does'nt create actual functions, and can be defined in multiple files
+ * without creating the same function multiple times, 
+ * and the compiler can optimize them as they are very small wrappers.
+ * 
+ * An other thing, I'm not an expert in dynammic arrays, so I just implemented
+ * a logic I came accross one time, and I've done it the way that seams the best for me.
+ * in vect_t, the property capacity is the number of elements the allocated array can hold,
+ * when the array is full it is multiplied by the growth factor of the array (2 by default)
+ * yes this means that there is unused memory in the array, but this make insertion and deletion
+ * fast as they are now O(log(n)) instead of O(n))
+ * (I speak in term of reallocation, which mean copying the array, only log2(n) times instead of n times)
+ * I also heard about the fact that computer likes to always be propare that functions are gonna be call multiple
+ * so when the user push to the front, if their is no space at the front, I move the array to the back,
+ * not just of one element, but of the whole array.
+ * I do the smae thing when the user push to the back, I just move the array to the front, setting the offset to 0.
+ * This whole logic is done in vec_expand() and vec_shrink(), which are just wrappers for vec_resize().
+ * no other functions than vec_resize() should resize, only move memory.
+ * all function that insert element in the vector call vec_expand(),
+ * and all function that remove element from the vector call vec_shrink().
+ * this insure that the array is always in the right size.
+ * the only function that can oversize the array is vec_reserve() (which is also a wrapper for vec_resize())
+ * 
+ * some macro are defined to access part of the array, see vec_: front, back, index, indexFromBack
+ * defined to make the code more readeable when moving memory around.
+ * 
+ * functions that intend to modify the vec size take the vec address as first argument,
+ * that way the memory address of the arr can be replaced by the new one if the array is resized.
+ * so all these function finish by *vecPtr = vec_front(vecInfo)
+ * 
+ * 
+ * I hope the code is not too hard to understand, I try to keep it as clean as possible,
+ * but this is difficult has it's mostly memory movement.
+ * this lib is just me tweaking around in C to improve myself,
+ * I'm sure most of the functions could be written in a better way and more optimized,
+ * If you see any improvement, please let me know.
+ * 
+ * Thanks for reading,
+ * have a nice day,
+ * Baptiste de Montangon.
+ */
@@ -1,256 +1,1908 @@
-#ifndef HEAD_VEC_T
-#define HEAD_VEC_T
-
-#include <stdlib.h>
-#include <stdio.h>
-
-/**  
- * All functions defined with macros are inlined (except for maps functions),
- * they are only wrappers for the internal functions (marked with _priv_),
- * made for abstraction. they will not create new functions, as the compiler will
- * inline them, so you can define them in all your files without creating
- * multiple time the same functions.
- * you also can define them in a header file, and include it in all your files.
- * 
- * You should use the macros, but if you feel you understand 
- * the mechanics of the internal functions, feel free to use them.
- * 
- * Functions that modify the array need the pointer to the array as parameter, 
- * not the array itself, param name will be vecPtr instead of vec.
- * 
- * DO NOT GIVE SHIFTED ARRAY TO THESE FUNCTIONS, THEY WILL NOT WORK.
- * exemple: if you give vec + x to vec_size, it will segfault if x != 0.
- * this doesn't mean you can't use shifted arrays, just don't give them to the functions,
- * it will segfault.
- * 
- * for all macros the first parameter is the array type,
- * the second parameter is a suffix for the functions, 
- * this way you can define functions for array of pointers.
- * 
- * for details about each function see the functions comments.
- * 
- * functions can be defined individually, but VEC_DEF_ALL() define all the functions at once.
- * 
- * You also can overwrite allocator and deallocator functions to use custom ones. 
- * 
- * if you intend to store large type, I would advice you to store them as pointers, as moving them
- * around in memory will be less expensive.
- */
-
-// return an array of the given type that can be accessed like a normal array
-// need to be freed with vec_free()
-#define VEC_DEF_CREATE(type, suffix) \
-    inline type* vec_create_##suffix(size_t _size) { \
-        return (type*)vec_create(sizeof(type), _size); \
-    } 
-
-// push an element to the end of the array
-// need the array pointer as parameter, not the array itself
-#define VEC_DEF_PUSHBACK(type, suffix) \
-    inline type vec_pushBack_##suffix(type** _vecPtr, type _value) { \
-        _vec_priv_pushBack((void**)_vecPtr, &_value); \
-        return _value; \
-    }
-
-// push an element to the front of the array
-// need the array pointer as parameter, not the array itself
-#define VEC_DEF_PUSHFRONT(type, suffix) \
-    inline type vec_pushFront_##suffix(type** _vecPtr, type _value) { \
-        _vec_priv_pushFront((void**)_vecPtr, &_value); \
-        return _value; \
-    }
-
-// pop an element from the end of the array
-// need the array pointer as parameter, not the array itself
-#define VEC_DEF_POPBACK(type, suffix) \
-    inline type vec_popBack_##suffix(type** _vecPtr) { \
-        type _buff; \
-        _vec_priv_popBack((void**)_vecPtr, &_buff); \
-        return _buff; \
-    }
-
-// pop an element from the front of the array
-// need the array pointer as parameter, not the array itself
-#define VEC_DEF_POPFRONT(type, suffix) \
-    inline type vec_popFront_##suffix(type** _vecPtr) { \
-        type _buff; \
-        _vec_priv_popFront((void**)_vecPtr, &_buff); \
-        return _buff; \
-    }
-
-// return a new array containing the elements of the given array
-// beetween the given indexes
-// need to be freed with vec_free()
-#define VEC_DEF_SLICE(type, suffix) \
-    inline type* vec_slice_##suffix(type* _vec, size_t _start, size_t _end) { \
-        return (type*)_vec_priv_slice(_vec, _start, _end); \
-    }
-
-// insert an element at the given index
-// need the array pointer as parameter, not the array itself
-// if index is out of bounds, the element will be pushed to the end of the array
-// if insertion is either at front or end, will fallback to pushBack or pushFront
-// for other index this is slower
-#define VEC_DEF_INSERT(type, suffix) \
-    inline type vec_insert_##suffix(type** _vecPtr, size_t _index, type _value) { \
-        _vec_priv_insert((void**)_vecPtr, _index, &_value); \
-        return _value; \
-    }
-
-// remove an element at the given index and return it
-// need the array pointer as parameter, not the array itself
-#define VEC_DEF_REMOVE(type, suffix) \
-    inline type vec_remove_##suffix(type** _vecPtr, size_t _index) { \
-        type _buff; \
-        _vec_priv_remove((void**)_vecPtr, _index, &_buff); \
-        return _buff; \
-    }
-
-// wrapper for bsearch, so behave just like it.
-// bsearch being inline, the size is saved in a variable to avoid recomputing it
-#define VEC_DEF_BSEARCH(type, suffix) \
-    inline type* vec_bsearch_##suffix(type* _vec, type _value, int (*_compar_fn) (const void *, const void *)) { \
-        size_t _size = vec_size(_vec); \
-        return bsearch(&_value, _vec, _size, sizeof(type), _compar_fn); \
-    }
-
-// clear the array, remove all elements and reset size to 0
-// need the array pointer as parameter, not the array itself
-#define VEC_DEF_CLEAR(type, suffix) \
-    inline void vec_clear_##suffix(type** _vecPtr) { \
-        _vec_priv_clear((void**)_vecPtr); \
-    }
-
-// insert an element in a already sorted array and keep it sorted
-// return the index of the element
-// need the comparator function to be set
-// if multiple elements are equal to the value, insert element at last position
-#define VEC_DEF_SORTEDINSERT(type, suffix) \
-    inline size_t vec_sortedInsert_##suffix(type** _vecPtr, type _value) { \
-        return _vec_priv_sortedInsert((void**)_vecPtr, &_value); \
-    }
-
-
-// commodity macro to define all functions
-#define VEC_DEF_ALL(type, suffix) \
-    VEC_DEF_CREATE(type, suffix) \
-    VEC_DEF_PUSHBACK(type, suffix) \
-    VEC_DEF_PUSHFRONT(type, suffix) \
-    VEC_DEF_POPBACK(type, suffix) \
-    VEC_DEF_POPFRONT(type, suffix) \
-    VEC_DEF_SLICE(type, suffix) \
-    VEC_DEF_INSERT(type, suffix) \
-    VEC_DEF_REMOVE(type, suffix) \
-    VEC_DEF_BSEARCH(type, suffix) \
-    VEC_DEF_CLEAR(type, suffix) \
-    VEC_DEF_SORTEDINSERT(type, suffix) \
-
-// map function is not inlined
-// so it will define a function that will be compiled.
-// if you use this in multiple files, you should define
-// the function in only one file.
-#define VEC_DEF_MAP(fromType, toType, suffix) \
-    toType* vec_map_##suffix(fromType* vec, toType (*map_fn)(fromType, size_t)) { \
-        size_t arrSize = vec_size(vec); \
-        toType* newArr = vec_create(sizeof(toType), arrSize); \
-        for(size_t i = 0; i < arrSize; i++) { \
-            newArr[i] = map_fn(vec[i], i); \
-        } \
-        return newArr; \
-    }
-
-// for next 2 functions, put the loop in a new block to scope the val variable
-
-// foreach emulations, can be used like:
-// vec_foreach(vec, int, i, val, 
-//     printf("%d\n", val);
-// )
-// val is the value of the current element
-// iter is the index iterator, contain index of current element
-#define vec_foreach(vec, type, iter, val, loop) \
-    { \
-        type val; \
-        for(size_t iter = 0; iter < vec_size(vec); iter++) {\
-            val = vec[iter]; \
-            loop \
-        } \
-    }
-
-// same as vec_foreach, but in reverse order
-#define vec_foreach_reverse(vec, type, iter, val, loop) \
-    { \
-        type val; \
-        for(size_t iter = vec_size(vec) - 1; iter >= 0; iter--) {\
-            val = vec[iter]; \
-            loop \
-        } \
-    }
-
-// define wrappers for compare function to be used with either bsearch or qsort
-// not inlined (for obvious reasons)
-#define DYNNAR_COMPARE_FN(type, suffix, compareFn) \
-    int vec_compare_##suffix(const void* a, const void* b) { \
-        return compareFn(*(type*)a, *(type*)b); \
-    }
-
-
-
-
-// public functions
-
-// create a new array of elements of size memSize and of min-size size
-// array will be of the given size, if you init it of size 10, every push will append after the 10th element
-// if you want to pre allocate memory, init with size 0 and use preAllocate() function
-void* vec_create(size_t memSize, size_t size);
-// return the size of the array
-size_t vec_size(const void* vec);
-// free the array
-void vec_free(void* vec);
-/**
- * sort the array, 
- * just a wrapper for qsort
- * if you plan to sort the array multiple times,
- * set the comparator function with vec_setComparator() and use vec_sort()
- */
-void vec_qsort(void* vec, int (*compar_fn) (const void *, const void *));
-// if resize is true :
-// allocate memory for newSize element and set the size to newSize
-// do nothing if newSize is smaller than the current size
-// if resize is false :
-// allocate memory for newSize element but keep the size, allowing to add elements with adding functions
-// without reallocating when place need to be made
-// do nothing if enough memory is already allocated
-// caution: functions that removes elements will automatically resize the array to its min-size
-void vec_allocate(void* vecPtr, size_t newSize, int resize);
-// reverse the array
-void vec_reverse(void* vec);
-// swap two elements in the array
-void vec_swap(void* vecPtr, size_t index1, size_t index2);
-// overwrite the allocator function of the library, default is malloc
-void vec_set_allocator(void* (*_allocator)(size_t));
-// overwrite the deallocator function of the library, default is free
-void vec_set_deallocator(void (*_deallocator)(void*));
-// set a comparator function for the array
-// allowing to use function for sorted arrays
-void vec_setComparator(void* vec, int (*cmp)(const void*, const void*));
-// sort the array,
-// need the comparator function to be set
-// wrapper for qsort, which is not stable
-void vec_sort(void* vec);
-// return if the array is sorted
-// need the comparator function to be set
-int vec_isSorted(const void* vec);
-
-// private functions
-void _vec_priv_pushBack(void** vecPtr, void* value);
-void _vec_priv_pushFront(void** vecPtr, void* value);
-void _vec_priv_popBack(void** vecPtr, void* buff);
-void _vec_priv_popFront(void** vecPtr, void* buff);
-void* _vec_priv_slice(void* vec, size_t start, size_t end);
-void _vec_priv_insert(void** vecPtr, size_t index, void* value);
-void _vec_priv_remove(void** vecPtr, size_t index, void* buff);
-void _vec_priv_clear(void** vecPtr);
-size_t _vec_priv_sortedInsert(void** vecPtr, void* value);
-void _vec_debug_print(void* vec, FILE* stream); // write informations about the array to the given stream, for debug purpose
-
+#ifndef HEAD_VEC_T
+#define HEAD_VEC_T
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**  
+ * All functions defined with macros are inlined (except for maps functions),
+ * they are only wrappers for the internal functions (marked with _priv_),
+ * made for abstraction. they will not create new functions, as the compiler will
+ * inline them, so you can define them in all your files without creating
+ * multiple time the same functions.
+ * you also can define them in a header file, and include it in all your files.
+ * 
+ * You should use the macros, but if you feel you understand 
+ * the mechanics of the internal functions, feel free to use them.
+ * 
+ * Functions that modify the array need the pointer to the array as parameter, 
+ * not the array itself, param name will be vecPtr instead of vec.
+ * 
+ * DO NOT GIVE SHIFTED ARRAY TO THESE FUNCTIONS, THEY WILL NOT WORK.
+ * exemple: if you give vec + x to vec_size, it will segfault if x != 0.
+ * this doesn't mean you can't use shifted arrays, just don't give them to the functions,
+ * it will segfault.
+ * 
+ * for all macros the first parameter is the array type,
+ * the second parameter is a suffix for the functions, 
+ * this way you can define functions for array of pointers.
+ * 
+ * for details about each function see the functions comments.
+ * 
+ * functions can be defined individually, but VEC_DEF_ALL() define all the functions at once.
+ * 
+ * You also can overwrite allocator and deallocator functions to use custom ones. 
+ * each array can also use its own allocator, see vec_allocator_t and vec_create_with_allocator(),
+ * the library provide an arena (vec_arena_t) and a pool (vec_pool_t) allocator.
+ * 
+ * if you intend to store large type, I would advice you to store them as pointers, as moving them
+ * around in memory will be less expensive.
+ */
+
+/**
+ * allocator used for the memory of an array, given to vec_create_with_allocator()
+ * ctx is given to the functions, and the size of the block is given back to free and realloc,
+ * so the allocator doesn't need to store it.
+ * realloc can be NULL, the block is then moved with alloc and free.
+ * realloc is used by the resizes when the elements are at the start of the array,
+ * if it fail it return NULL and the old block need to be left untouched (like the standard realloc).
+ * the allocator is stored by address in the array, so it need to live as long as the arrays using it.
+ * temporary buffers (swap, sorts...) always use the allocator of the library, see vec_set_allocator()
+ */
+typedef struct {
+    void* (*alloc)(void* ctx, size_t size);
+    void* (*realloc)(void* ctx, void* ptr, size_t oldSize, size_t newSize);
+    void (*free)(void* ctx, void* ptr, size_t size);
+    void* ctx;
+} vec_allocator_t;
+
+// bump allocator: allocations are taken one after the other in big blocks,
+// free only give back the memory of the last allocation, and vec_arena_reset() free everything at once.
+// made for arrays with the same lifetime, like all the arrays of a request. not thread safe.
+typedef struct vec_arena_s vec_arena_t;
+// size class allocator: the blocks are rounded up to a power of 2 and freed blocks are kept
+// in a list per size, to be reused by the next allocation of the same class.
+// made for lots of arrays created and freed in a loop. not thread safe.
+typedef struct vec_pool_s vec_pool_t;
+
+/**
+ * counters of the library, only counted if vector.c is compiled with VEC_STATS defined
+ * (without it, they are not compiled at all and the functions return zeros)
+ * they exist for each array and for the whole library, see vec_getStats()
+ */
+typedef struct {
+    size_t resizes; // number of reallocations of the arrays
+    size_t bytesCopied; // bytes copied to new blocks by the resizes
+    size_t bytesMoved; // bytes moved inside the arrays (insertions, removals, compactions)
+    size_t bytesRebased; // bytes moved by vec_pushFront() and vec_pushFrontN() to make room at the front
+    size_t allocatedBytes; // bytes currently allocated for the arrays
+    size_t peakBytes; // biggest value of allocatedBytes
+    size_t allocFailures; // failed allocations of arrays (only counted globally)
+} vec_stats_t;
+
+// return an array of the given type that can be accessed like a normal array
+// need to be freed with vec_free()
+#define VEC_DEF_CREATE(type, suffix) \
+    inline type* vec_create_##suffix(size_t _size) { \
+        return (type*)vec_create(sizeof(type), _size); \
+    } \
+    inline type* vec_create_with_allocator_##suffix(size_t _size, const vec_allocator_t* _allocator) { \
+        return (type*)vec_create_with_allocator(sizeof(type), _size, _allocator); \
+    } \
+    inline type* vec_create_aligned_##suffix(size_t _size, size_t _align) { \
+        return (type*)vec_create_aligned(sizeof(type), _size, _align); \
+    } 
+
+// push an element to the end of the array
+// need the array pointer as parameter, not the array itself
+#define VEC_DEF_PUSHBACK(type, suffix) \
+    inline type vec_pushBack_##suffix(type** _vecPtr, type _value) { \
+        _vec_priv_pushBack((void**)_vecPtr, &_value); \
+        return _value; \
+    }
+
+// push an element to the front of the array
+// need the array pointer as parameter, not the array itself
+#define VEC_DEF_PUSHFRONT(type, suffix) \
+    inline type vec_pushFront_##suffix(type** _vecPtr, type _value) { \
+        _vec_priv_pushFront((void**)_vecPtr, &_value); \
+        return _value; \
+    }
+
+// push count elements to the end of the array, in the same order
+// the array grows at most once and the values are copied in one go,
+// so this is faster than count pushBack
+// values can point into the array itself, they are copied before it grows
+// need the array pointer as parameter, not the array itself
+#define VEC_DEF_PUSHBACKN(type, suffix) \
+    inline void vec_pushBackN_##suffix(type** _vecPtr, const type* _values, size_t _count) { \
+        _vec_priv_pushBackN((void**)_vecPtr, _values, _count); \
+    }
+
+// push count elements to the front of the array, in the same order,
+// so after the call _values[0] is the first element of the array
+// values can point into the array itself, they are copied before it grows
+// need the array pointer as parameter, not the array itself
+#define VEC_DEF_PUSHFRONTN(type, suffix) \
+    inline void vec_pushFrontN_##suffix(type** _vecPtr, const type* _values, size_t _count) { \
+        _vec_priv_pushFrontN((void**)_vecPtr, _values, _count); \
+    }
+
+// pop an element from the end of the array
+// need the array pointer as parameter, not the array itself
+#define VEC_DEF_POPBACK(type, suffix) \
+    inline type vec_popBack_##suffix(type** _vecPtr) { \
+        type _buff; \
+        _vec_priv_popBack((void**)_vecPtr, &_buff); \
+        return _buff; \
+    }
+
+// pop an element from the front of the array
+// need the array pointer as parameter, not the array itself
+#define VEC_DEF_POPFRONT(type, suffix) \
+    inline type vec_popFront_##suffix(type** _vecPtr) { \
+        type _buff; \
+        _vec_priv_popFront((void**)_vecPtr, &_buff); \
+        return _buff; \
+    }
+
+// return a new array containing the elements of the given array
+// beetween the given indexes
+// need to be freed with vec_free()
+#define VEC_DEF_SLICE(type, suffix) \
+    inline type* vec_slice_##suffix(type* _vec, size_t _start, size_t _end) { \
+        return (type*)_vec_priv_slice(_vec, _start, _end); \
+    }
+
+// insert an element at the given index
+// need the array pointer as parameter, not the array itself
+// if index is out of bounds, the element will be pushed to the end of the array
+// if insertion is either at front or end, will fallback to pushBack or pushFront
+// for other index this is slower
+#define VEC_DEF_INSERT(type, suffix) \
+    inline type vec_insert_##suffix(type** _vecPtr, size_t _index, type _value) { \
+        _vec_priv_insert((void**)_vecPtr, _index, &_value); \
+        return _value; \
+    }
+
+// insert count elements at the given index, in the same order
+// need the array pointer as parameter, not the array itself
+// if index is out of bounds, nothing is inserted
+// the elements after index are moved only once
+// values can point into the array itself, they are copied before it grows
+#define VEC_DEF_INSERTRANGE(type, suffix) \
+    inline void vec_insertRange_##suffix(type** _vecPtr, size_t _index, const type* _values, size_t _count) { \
+        _vec_priv_insertRange((void**)_vecPtr, _index, _values, _count); \
+    }
+
+// remove an element at the given index and return it
+// need the array pointer as parameter, not the array itself
+#define VEC_DEF_REMOVE(type, suffix) \
+    inline type vec_remove_##suffix(type** _vecPtr, size_t _index) { \
+        type _buff; \
+        _vec_priv_remove((void**)_vecPtr, _index, &_buff); \
+        return _buff; \
+    }
+
+// remove the elements beetween the given indexes, end excluded
+// need the array pointer as parameter, not the array itself
+// if end is out of bounds, remove until the end of the array
+// the elements are moved once, and the array is shrinked once, unlike multiple calls to remove
+#define VEC_DEF_ERASERANGE(type, suffix) \
+    inline void vec_eraseRange_##suffix(type** _vecPtr, size_t _start, size_t _end) { \
+        _vec_priv_eraseRange((void**)_vecPtr, _start, _end); \
+    }
+
+// wrapper for bsearch, so behave just like it.
+// bsearch being inline, the size is saved in a variable to avoid recomputing it
+#define VEC_DEF_BSEARCH(type, suffix) \
+    inline type* vec_bsearch_##suffix(type* _vec, type _value, int (*_compar_fn) (const void *, const void *)) { \
+        size_t _size = vec_size(_vec); \
+        return bsearch(&_value, _vec, _size, sizeof(type), _compar_fn); \
+    }
+
+// clear the array, remove all elements and reset size to 0
+// need the array pointer as parameter, not the array itself
+#define VEC_DEF_CLEAR(type, suffix) \
+    inline void vec_clear_##suffix(type** _vecPtr) { \
+        _vec_priv_clear((void**)_vecPtr); \
+    }
+
+// insert an element in a already sorted array and keep it sorted
+// return the index of the element
+// need the comparator function to be set
+// if multiple elements are equal to the value, insert element at last position
+#define VEC_DEF_SORTEDINSERT(type, suffix) \
+    inline size_t vec_sortedInsert_##suffix(type** _vecPtr, type _value) { \
+        return _vec_priv_sortedInsert((void**)_vecPtr, &_value); \
+    }
+
+// insert count elements in a already sorted array and keep it sorted
+// need the comparator function to be set
+// the values are sorted and merged with the array in one pass, growing it once,
+// so this is O(size + count * log(count)) instead of count memmove of the array
+// like vec_sortedInsert, values equal to elements of the array are inserted after them
+#define VEC_DEF_SORTEDINSERTN(type, suffix) \
+    inline void vec_sortedInsertN_##suffix(type** _vecPtr, const type* _values, size_t _count) { \
+        _vec_priv_sortedInsertN((void**)_vecPtr, _values, _count); \
+    }
+
+
+/**
+ * a view is a window on the elements of an array, without allocation or copy
+ * views are created with vec_view() and vec_view_sub(), and can be given to the
+ * sort, search and reduction functions (vec_view_ versions).
+ * a view is invalidated by every function that can move the elements of its parent array,
+ * so by all functions that add or remove elements (they can call vec_resize() or move the front of the array)
+ */
+typedef struct {
+    void* data; // first element of the view
+    size_t size; // number of elements
+    size_t memSize; // size of 1 element
+    const void* parent; // the array the view was taken from
+} vec_view_t;
+
+// typed accessors for views
+// vec_view_data_##suffix return the elements as an array, with the size of the view
+// get and set are not bound checked
+#define VEC_DEF_VIEW(type, suffix) \
+    inline type* vec_view_data_##suffix(vec_view_t _view) { \
+        return (type*)_view.data; \
+    } \
+    inline type vec_view_get_##suffix(vec_view_t _view, size_t _index) { \
+        return ((type*)_view.data)[_index]; \
+    } \
+    inline void vec_view_set_##suffix(vec_view_t _view, size_t _index, type _value) { \
+        ((type*)_view.data)[_index] = _value; \
+    }
+
+// commodity macro to define all functions
+#define VEC_DEF_ALL(type, suffix) \
+    VEC_DEF_CREATE(type, suffix) \
+    VEC_DEF_PUSHBACK(type, suffix) \
+    VEC_DEF_PUSHFRONT(type, suffix) \
+    VEC_DEF_PUSHBACKN(type, suffix) \
+    VEC_DEF_PUSHFRONTN(type, suffix) \
+    VEC_DEF_POPBACK(type, suffix) \
+    VEC_DEF_POPFRONT(type, suffix) \
+    VEC_DEF_SLICE(type, suffix) \
+    VEC_DEF_INSERT(type, suffix) \
+    VEC_DEF_INSERTRANGE(type, suffix) \
+    VEC_DEF_REMOVE(type, suffix) \
+    VEC_DEF_ERASERANGE(type, suffix) \
+    VEC_DEF_BSEARCH(type, suffix) \
+    VEC_DEF_CLEAR(type, suffix) \
+    VEC_DEF_SORTEDINSERT(type, suffix) \
+    VEC_DEF_SORTEDINSERTN(type, suffix) \
+    VEC_DEF_VIEW(type, suffix) \
+
+// map function is not inlined
+// so it will define a function that will be compiled.
+// if you use this in multiple files, you should define
+// the function in only one file.
+#define VEC_DEF_MAP(fromType, toType, suffix) \
+    toType* vec_map_##suffix(fromType* vec, toType (*map_fn)(fromType, size_t)) { \
+        size_t arrSize = vec_size(vec); \
+        toType* newArr = vec_create(sizeof(toType), arrSize); \
+        for(size_t i = 0; i < arrSize; i++) { \
+            newArr[i] = map_fn(vec[i], i); \
+        } \
+        return newArr; \
+    }
+
+// pool of threads for the parallel map, filter and reduce, see vec_threadPool_create()
+typedef struct vec_threadPool_s vec_threadPool_t;
+
+/**
+ * the next 3 macros define functions running a loop on the elements of an array with the threads of a pool,
+ * the array is split in one part per thread, the parts start on a cache line of the output when possible.
+ * with a NULL pool, or less than 2 parts of 4096 elements, the loop is run in the calling thread.
+ * a loop started from the expression of another one (on any pool) is run serially by the thread running that part.
+ * the result is written in *outPtr if outPtr and *outPtr are not NULL (the array is resized, keeping its memory when it get smaller,
+ * and may be the input array itself if the types are the same), else in a new array.
+ * like map functions, they are not inlined, so define them in only one file.
+ */
+
+// define vec_parallelMap_##suffix(pool, vec, outPtr, ctx), that set out[i] to mapExpr for each element of vec
+// and return out (NULL if it can't be allocated).
+// mapExpr is an expression using a (the element), i (its index) and ctx (the void* given to the function),
+// exemple: VEC_DEF_PARALLEL_MAP(point_t, float, norm, sqrtf(a.x * a.x + a.y * a.y))
+#define VEC_DEF_PARALLEL_MAP(fromType, toType, suffix, mapExpr) \
+    static inline toType _vec_priv_mapOne_##suffix(fromType a, size_t i, void* ctx) { \
+        return (mapExpr); \
+    } \
+    typedef struct { \
+        const fromType* in; \
+        toType* out; \
+        void* ctx; \
+    } _vec_priv_mapCtx_##suffix##_t; \
+    static void _vec_priv_mapPart_##suffix(void* _arg, size_t _start, size_t _end, size_t _part) { \
+        _vec_priv_mapCtx_##suffix##_t* _c = _arg; \
+        for(size_t _i = _start; _i < _end; _i++) { \
+            _c->out[_i] = _vec_priv_mapOne_##suffix(_c->in[_i], _i, _c->ctx); \
+        } \
+    } \
+    toType* vec_parallelMap_##suffix(vec_threadPool_t* _pool, const fromType* _vec, toType** _outPtr, void* _ctx) { \
+        size_t _n = vec_size(_vec); \
+        toType* _out = _vec_priv_outputArray((void**)_outPtr, sizeof(toType), _n); \
+        if(_out == NULL) return NULL; \
+        _vec_priv_mapCtx_##suffix##_t _c = { _vec, _out, _ctx }; \
+        _vec_priv_parallelFor(_pool, _n, sizeof(toType), _out, _vec_priv_mapPart_##suffix, &_c); \
+        return _out; \
+    }
+
+// define vec_parallelFilter_##suffix(pool, vec, outPtr, ctx), that copy the elements of vec for which predExpr is true
+// to out, in the same order, and return out (NULL if it can't be allocated).
+// predExpr is an expression using a (the element) and ctx (the void* given to the function),
+// exemple: VEC_DEF_PARALLEL_FILTER(entry_t, valid, a.deadline >= *(time_t*)ctx)
+// each thread compact the elements of its part, then the parts are moved together.
+#define VEC_DEF_PARALLEL_FILTER(type, suffix, predExpr) \
+    static inline int _vec_priv_filterPred_##suffix(type a, void* ctx) { \
+        return (predExpr); \
+    } \
+    typedef struct { \
+        const type* in; \
+        type* out; \
+        size_t* starts; \
+        size_t* counts; \
+        void* ctx; \
+    } _vec_priv_filterCtx_##suffix##_t; \
+    static void _vec_priv_filterPart_##suffix(void* _arg, size_t _start, size_t _end, size_t _part) { \
+        _vec_priv_filterCtx_##suffix##_t* _c = _arg; \
+        size_t _write = _start; \
+        for(size_t _i = _start; _i < _end; _i++) { \
+            if(_vec_priv_filterPred_##suffix(_c->in[_i], _c->ctx)) { \
+                _c->out[_write++] = _c->in[_i]; \
+            } \
+        } \
+        _c->starts[_part] = _start; \
+        _c->counts[_part] = _write - _start; \
+    } \
+    type* vec_parallelFilter_##suffix(vec_threadPool_t* _pool, const type* _vec, type** _outPtr, void* _ctx) { \
+        size_t _n = vec_size(_vec); \
+        type* _out = _vec_priv_outputArray((void**)_outPtr, sizeof(type), _n); \
+        if(_out == NULL) return NULL; \
+        size_t _parts = vec_threadPool_size(_pool); \
+        size_t _starts[_parts], _counts[_parts]; \
+        memset(_counts, 0, sizeof(_counts)); \
+        _vec_priv_filterCtx_##suffix##_t _c = { _vec, _out, _starts, _counts, _ctx }; \
+        _vec_priv_parallelFor(_pool, _n, sizeof(type), _out, _vec_priv_filterPart_##suffix, &_c); \
+        size_t _total = 0; \
+        for(size_t _p = 0; _p < _parts; _p++) { \
+            if(_counts[_p] == 0) continue; \
+            if(_starts[_p] != _total) memmove(_out + _total, _out + _starts[_p], _counts[_p] * sizeof(type)); \
+            _total += _counts[_p]; \
+        } \
+        _vec_priv_truncate(_out, _total); \
+        if(_outPtr != NULL) *_outPtr = _out; \
+        return _out; \
+    }
+
+// define vec_parallelReduce_##suffix(pool, vec, init, ctx), that reduce the elements of vec to an accType
+// each thread start from init and fold the elements of its part with foldExpr, using acc (the accumulator),
+// a (the element) and ctx, then the results of the parts are combined in order with combineExpr, using acc and b.
+// so init need to be neutral for combineExpr (0 for a sum, 1 for a product, INT_MIN for a max...)
+// exemple: VEC_DEF_PARALLEL_REDUCE(int, long long, sum, acc + a, acc + b)
+#define VEC_DEF_PARALLEL_REDUCE(type, accType, suffix, foldExpr, combineExpr) \
+    static inline accType _vec_priv_fold_##suffix(accType acc, type a, void* ctx) { \
+        return (foldExpr); \
+    } \
+    static inline accType _vec_priv_combine_##suffix(accType acc, accType b, void* ctx) { \
+        return (combineExpr); \
+    } \
+    typedef struct { \
+        const type* in; \
+        accType* results; \
+        void* ctx; \
+    } _vec_priv_reduceCtx_##suffix##_t; \
+    static void _vec_priv_reducePart_##suffix(void* _arg, size_t _start, size_t _end, size_t _part) { \
+        _vec_priv_reduceCtx_##suffix##_t* _c = _arg; \
+        accType _acc = _c->results[_part]; \
+        for(size_t _i = _start; _i < _end; _i++) { \
+            _acc = _vec_priv_fold_##suffix(_acc, _c->in[_i], _c->ctx); \
+        } \
+        _c->results[_part] = _acc; \
+    } \
+    accType vec_parallelReduce_##suffix(vec_threadPool_t* _pool, const type* _vec, accType _init, void* _ctx) { \
+        size_t _parts = vec_threadPool_size(_pool); \
+        accType _results[_parts]; \
+        for(size_t _p = 0; _p < _parts; _p++) _results[_p] = _init; \
+        _vec_priv_reduceCtx_##suffix##_t _c = { _vec, _results, _ctx }; \
+        _vec_priv_parallelFor(_pool, vec_size(_vec), sizeof(type), _vec, _vec_priv_reducePart_##suffix, &_c); \
+        accType _acc = _results[0]; \
+        for(size_t _p = 1; _p < _parts; _p++) { \
+            _acc = _vec_priv_combine_##suffix(_acc, _results[_p], _ctx); \
+        } \
+        return _acc; \
+    }
+
+// under this number of elements, the sort functions defined by VEC_DEF_SORT use an insertion sort
+#define VEC_SORT_INSERTION_THRESHOLD 16
+
+// define a sort function specialized for the given type, vec_sort_##suffix(vec), and vec_view_sort_##suffix(view)
+// lessExpr is an expression using a and b (of the given type) that is true if a < b,
+// exemple: VEC_DEF_SORT(int, int, a < b) or VEC_DEF_SORT(point_t, point, a.x < b.x)
+// it's an introsort (quicksort, falling back to heapsort on bad pivots, and insertion sort for small parts)
+// comparisons and swaps are done on the type directly, so they are inlined by the compiler,
+// unlike vec_sort() which call the comparator for each comparison.
+// not stable, and the comparator of the array is not used.
+// like map functions, they are not inlined, so define them in only one file.
+#define VEC_DEF_SORT(type, suffix, lessExpr) \
+    static inline int _vec_priv_less_##suffix(type a, type b) { \
+        return (lessExpr); \
+    } \
+    void _vec_priv_insertionSort_##suffix(type* _arr, size_t _n) { \
+        for(size_t _i = 1; _i < _n; _i++) { \
+            type _val = _arr[_i]; \
+            size_t _j = _i; \
+            while(_j > 0 && _vec_priv_less_##suffix(_val, _arr[_j - 1])) { \
+                _arr[_j] = _arr[_j - 1]; \
+                _j--; \
+            } \
+            _arr[_j] = _val; \
+        } \
+    } \
+    void _vec_priv_heapSort_##suffix(type* _arr, size_t _n) { \
+        for(size_t _start = _n / 2, _end = _n; _end > 1;) { \
+            size_t _i; \
+            if(_start > 0) { \
+                /* build the heap */ \
+                _i = --_start; \
+            } else { \
+                /* move the max to the end and fix the heap */ \
+                _end--; \
+                type _tmp = _arr[0]; _arr[0] = _arr[_end]; _arr[_end] = _tmp; \
+                _i = 0; \
+            } \
+            type _val = _arr[_i]; \
+            size_t _child; \
+            while((_child = 2 * _i + 1) < _end) { \
+                if(_child + 1 < _end && _vec_priv_less_##suffix(_arr[_child], _arr[_child + 1])) _child++; \
+                if(!_vec_priv_less_##suffix(_val, _arr[_child])) break; \
+                _arr[_i] = _arr[_child]; \
+                _i = _child; \
+            } \
+            _arr[_i] = _val; \
+        } \
+    } \
+    void _vec_priv_introSort_##suffix(type* _arr, size_t _n, unsigned _depth) { \
+        while(_n > VEC_SORT_INSERTION_THRESHOLD) { \
+            if(_depth == 0) { \
+                _vec_priv_heapSort_##suffix(_arr, _n); \
+                return; \
+            } \
+            _depth--; \
+            /* median of 3, the median end up in the middle */ \
+            size_t _m = _n / 2; \
+            type _tmp; \
+            if(_vec_priv_less_##suffix(_arr[_m], _arr[0])) { _tmp = _arr[_m]; _arr[_m] = _arr[0]; _arr[0] = _tmp; } \
+            if(_vec_priv_less_##suffix(_arr[_n - 1], _arr[_m])) { \
+                _tmp = _arr[_m]; _arr[_m] = _arr[_n - 1]; _arr[_n - 1] = _tmp; \
+                if(_vec_priv_less_##suffix(_arr[_m], _arr[0])) { _tmp = _arr[_m]; _arr[_m] = _arr[0]; _arr[0] = _tmp; } \
+            } \
+            /* hoare partition, [0, _j] <= pivot <= [_j + 1, _n) */ \
+            type _pivot = _arr[_m]; \
+            size_t _i = 0, _j = _n - 1; \
+            for(;;) { \
+                while(_vec_priv_less_##suffix(_arr[_i], _pivot)) _i++; \
+                while(_vec_priv_less_##suffix(_pivot, _arr[_j])) _j--; \
+                if(_i >= _j) break; \
+                _tmp = _arr[_i]; _arr[_i] = _arr[_j]; _arr[_j] = _tmp; \
+                _i++; \
+                _j--; \
+            } \
+            /* recurse on the smallest part, loop on the biggest */ \
+            if(_j + 1 < _n - _j - 1) { \
+                _vec_priv_introSort_##suffix(_arr, _j + 1, _depth); \
+                _arr += _j + 1; \
+                _n -= _j + 1; \
+            } else { \
+                _vec_priv_introSort_##suffix(_arr + _j + 1, _n - _j - 1, _depth); \
+                _n = _j + 1; \
+            } \
+        } \
+        _vec_priv_insertionSort_##suffix(_arr, _n); \
+    } \
+    void _vec_priv_sortPart_##suffix(void* _arr, size_t _n) { \
+        unsigned _depth = 0; \
+        for(size_t _k = _n; _k > 1; _k >>= 1) _depth += 2; \
+        _vec_priv_introSort_##suffix(_arr, _n, _depth); \
+    } \
+    void vec_sort_##suffix(type* _vec) { \
+        _vec_priv_sortPart_##suffix(_vec, vec_size(_vec)); \
+    } \
+    void vec_view_sort_##suffix(vec_view_t _view) { \
+        _vec_priv_sortPart_##suffix(_view.data, _view.size); \
+    }
+
+// define a parallel version of the sort defined by VEC_DEF_SORT (which need to be defined before),
+// vec_sort_parallel_##suffix(vec, nthreads) and vec_view_sort_parallel_##suffix(view, nthreads), see vec_sort_parallel()
+// parts are sorted with the specialized sort and merged with a specialized merge.
+// like map functions, they are not inlined, so define them in only one file.
+#define VEC_DEF_SORT_PARALLEL(type, suffix) \
+    int _vec_priv_compare_##suffix(const void* _a, const void* _b) { \
+        if(_vec_priv_less_##suffix(*(const type*)_a, *(const type*)_b)) return -1; \
+        return _vec_priv_less_##suffix(*(const type*)_b, *(const type*)_a); \
+    } \
+    void _vec_priv_merge_##suffix(const void* _a, size_t _na, const void* _b, size_t _nb, void* _out) { \
+        const type* _ta = _a; \
+        const type* _tb = _b; \
+        type* _tout = _out; \
+        size_t _i = 0, _j = 0; \
+        while(_i < _na && _j < _nb) { \
+            if(_vec_priv_less_##suffix(_tb[_j], _ta[_i])) { \
+                *_tout++ = _tb[_j++]; \
+            } else { \
+                *_tout++ = _ta[_i++]; \
+            } \
+        } \
+        while(_i < _na) *_tout++ = _ta[_i++]; \
+        while(_j < _nb) *_tout++ = _tb[_j++]; \
+    } \
+    void vec_view_sort_parallel_##suffix(vec_view_t _view, size_t _nthreads) { \
+        _vec_priv_sortParallel(_view, _nthreads, _vec_priv_compare_##suffix, \
+            _vec_priv_sortPart_##suffix, _vec_priv_merge_##suffix); \
+    } \
+    void vec_sort_parallel_##suffix(type* _vec, size_t _nthreads) { \
+        vec_view_sort_parallel_##suffix(vec_view(_vec, 0, vec_size(_vec)), _nthreads); \
+    }
+
+// range of indexes [start, end), returned by the equalRange functions
+typedef struct {
+    size_t start;
+    size_t end;
+} vec_range_t;
+
+// define search functions for a sorted array, using the order defined by VEC_DEF_SORT (which need to be defined before)
+// vec_lowerBound_##suffix(vec, value): index of the first element not less than value (size if none)
+// vec_upperBound_##suffix(vec, value): index of the first element greater than value (size if none)
+// vec_equalRange_##suffix(vec, value): range of the elements equal to value
+// (vec_view_ versions search in a view, and return indexes in the view)
+// the binary searches are branchless (the compiler use conditional moves) and prefetch the next middles,
+// so there is no misprediction at each level like with bsearch
+//
+// for read mostly arrays, vec_eytzinger_##suffix(vec) (or vec_view_eytzinger_##suffix(view))
+// return a new array (to free with vec_free())
+// with the elements of the sorted array in Eytzinger order (breadth first order of a binary search tree),
+// the first levels stay in cache and the next levels can be prefetched, so search on big arrays are faster.
+// vec_eytzingerLowerBound_##suffix(eytz, value) return the index in eytz of the first element not less than value
+// (size if none), the Eytzinger array need to be rebuilt if the sorted array is modified.
+// like map functions, they are not inlined, so define them in only one file.
+#define VEC_DEF_SEARCH(type, suffix) \
+    size_t _vec_priv_lowerBound_##suffix(const type* _vec, size_t _n, type _value) { \
+        if(_n == 0) return 0; \
+        const type* _base = _vec; \
+        while(_n > 1) { \
+            size_t _half = _n / 2; \
+            __builtin_prefetch(_base + _half / 2); \
+            __builtin_prefetch(_base + _half + _half / 2); \
+            _base = _vec_priv_less_##suffix(_base[_half], _value) ? _base + _half : _base; \
+            _n -= _half; \
+        } \
+        return (_base - _vec) + _vec_priv_less_##suffix(*_base, _value); \
+    } \
+    size_t _vec_priv_upperBound_##suffix(const type* _vec, size_t _n, type _value) { \
+        if(_n == 0) return 0; \
+        const type* _base = _vec; \
+        while(_n > 1) { \
+            size_t _half = _n / 2; \
+            __builtin_prefetch(_base + _half / 2); \
+            __builtin_prefetch(_base + _half + _half / 2); \
+            _base = !_vec_priv_less_##suffix(_value, _base[_half]) ? _base + _half : _base; \
+            _n -= _half; \
+        } \
+        return (_base - _vec) + !_vec_priv_less_##suffix(_value, *_base); \
+    } \
+    size_t vec_lowerBound_##suffix(const type* _vec, type _value) { \
+        return _vec_priv_lowerBound_##suffix(_vec, vec_size(_vec), _value); \
+    } \
+    size_t vec_upperBound_##suffix(const type* _vec, type _value) { \
+        return _vec_priv_upperBound_##suffix(_vec, vec_size(_vec), _value); \
+    } \
+    vec_range_t vec_equalRange_##suffix(const type* _vec, type _value) { \
+        size_t _n = vec_size(_vec); \
+        vec_range_t _range; \
+        _range.start = _vec_priv_lowerBound_##suffix(_vec, _n, _value); \
+        _range.end = _vec_priv_upperBound_##suffix(_vec, _n, _value); \
+        return _range; \
+    } \
+    size_t vec_view_lowerBound_##suffix(vec_view_t _view, type _value) { \
+        return _vec_priv_lowerBound_##suffix(_view.data, _view.size, _value); \
+    } \
+    size_t vec_view_upperBound_##suffix(vec_view_t _view, type _value) { \
+        return _vec_priv_upperBound_##suffix(_view.data, _view.size, _value); \
+    } \
+    vec_range_t vec_view_equalRange_##suffix(vec_view_t _view, type _value) { \
+        vec_range_t _range; \
+        _range.start = _vec_priv_lowerBound_##suffix(_view.data, _view.size, _value); \
+        _range.end = _vec_priv_upperBound_##suffix(_view.data, _view.size, _value); \
+        return _range; \
+    } \
+    size_t _vec_priv_eytzingerFill_##suffix(const type* _sorted, type* _out, size_t _i, size_t _n, size_t _k) { \
+        if(_i <= _n) { \
+            _k = _vec_priv_eytzingerFill_##suffix(_sorted, _out, 2 * _i, _n, _k); \
+            _out[_i - 1] = _sorted[_k++]; \
+            _k = _vec_priv_eytzingerFill_##suffix(_sorted, _out, 2 * _i + 1, _n, _k); \
+        } \
+        return _k; \
+    } \
+    type* vec_view_eytzinger_##suffix(vec_view_t _view) { \
+        type* _eytz = vec_create(sizeof(type), _view.size); \
+        if(_eytz == NULL) return NULL; \
+        _vec_priv_eytzingerFill_##suffix(_view.data, _eytz, 1, _view.size, 0); \
+        return _eytz; \
+    } \
+    type* vec_eytzinger_##suffix(const type* _vec) { \
+        return vec_view_eytzinger_##suffix(vec_view(_vec, 0, vec_size(_vec))); \
+    } \
+    size_t vec_eytzingerLowerBound_##suffix(const type* _eytz, type _value) { \
+        size_t _n = vec_size(_eytz); \
+        /* 1 based index, children of i are 2i and 2i + 1 */ \
+        size_t _i = 1; \
+        while(_i <= _n) { \
+            /* the 16 descendants 4 levels down are contiguous */ \
+            __builtin_prefetch(_eytz + 16 * _i - 1); \
+            _i = 2 * _i + _vec_priv_less_##suffix(_eytz[_i - 1], _value); \
+        } \
+        /* go back up to the last node where the search went left */ \
+        _i >>= __builtin_ffsll(~_i); \
+        return _i == 0 ? _n : _i - 1; \
+    }
+
+// when an input of a set operation is this many times bigger than the other,
+// its elements are skipped with exponential searches instead of one by one
+#define VEC_SET_GALLOP_RATIO 8
+
+/**
+ * define set operations for sorted arrays, using the order defined by VEC_DEF_SORT
+ * and the searches of VEC_DEF_SEARCH (which need to be defined before).
+ * like the std::set_ functions, the inputs can contain duplicates (multisets):
+ * vec_setUnion_##suffix(a, b, outPtr): elements of a or b (an element in both is kept once per pair)
+ * vec_setIntersection_##suffix(a, b, outPtr): elements of a that are also in b
+ * vec_setDifference_##suffix(a, b, outPtr): elements of a that are not in b
+ * vec_setSymmetricDifference_##suffix(a, b, outPtr): elements of a or b that are not in the other
+ * vec_setIncludes_##suffix(a, b): true if all elements of b are in a
+ * vec_unique_##suffix(vecPtr): remove the consecutive equal elements (keeping the first one),
+ * in place, and return the number of removed elements, the array doesn't need to be sorted
+ * (a and b are equal when neither is less than the other)
+ * the operations write the result in *outPtr if outPtr and *outPtr are not NULL, keeping its memory
+ * for the next calls, else in a new array, and return it (NULL if it can't be allocated).
+ * the output array can't be a or b.
+ * when an input is VEC_SET_GALLOP_RATIO times bigger than the other, the runs of its elements
+ * between the elements of the other are found with exponential searches, and copied in one go,
+ * so intersecting a small array with a big one is O(small * log(big)) instead of O(small + big).
+ * like map functions, they are not inlined, so define them in only one file.
+ */
+#define VEC_DEF_SET(type, suffix) \
+    /* number of elements at the start of arr less than value, found one by one or with an exponential search */ \
+    static inline size_t _vec_priv_setSkip_##suffix(const type* _arr, size_t _n, type _value, int _gallop) { \
+        if(!_gallop) { \
+            size_t _i = 0; \
+            while(_i < _n && _vec_priv_less_##suffix(_arr[_i], _value)) _i++; \
+            return _i; \
+        } \
+        if(_n == 0 || !_vec_priv_less_##suffix(_arr[0], _value)) return 0; \
+        size_t _prev = 0, _bound = 1; \
+        while(_bound < _n && _vec_priv_less_##suffix(_arr[_bound], _value)) { \
+            _prev = _bound; \
+            _bound = _bound * 2 + 1; \
+        } \
+        if(_bound > _n) _bound = _n; \
+        return _prev + 1 + _vec_priv_lowerBound_##suffix(_arr + _prev + 1, _bound - _prev - 1, _value); \
+    } \
+    /* merge a and b to out, copying the elements only in a and only in b if keepA and keepB, */ \
+    /* and one of the equal pairs if keepBoth, return the number of elements written */ \
+    static inline size_t _vec_priv_setMerge_##suffix(const type* _a, size_t _na, const type* _b, size_t _nb, \
+            type* _out, int _keepA, int _keepB, int _keepBoth) { \
+        int _gallopA = _na / VEC_SET_GALLOP_RATIO >= _nb; \
+        int _gallopB = _nb / VEC_SET_GALLOP_RATIO >= _na; \
+        size_t _i = 0, _j = 0, _w = 0; \
+        while(_i < _na && _j < _nb) { \
+            size_t _run = _vec_priv_setSkip_##suffix(_a + _i, _na - _i, _b[_j], _gallopA); \
+            if(_keepA) { \
+                memcpy(_out + _w, _a + _i, _run * sizeof(type)); \
+                _w += _run; \
+            } \
+            _i += _run; \
+            if(_i == _na) break; \
+            _run = _vec_priv_setSkip_##suffix(_b + _j, _nb - _j, _a[_i], _gallopB); \
+            if(_keepB) { \
+                memcpy(_out + _w, _b + _j, _run * sizeof(type)); \
+                _w += _run; \
+            } \
+            _j += _run; \
+            if(_j == _nb) break; \
+            /* b[j] is not less than a[i], they are equal if a[i] is not less than b[j] */ \
+            if(_vec_priv_less_##suffix(_a[_i], _b[_j])) continue; \
+            if(_keepBoth) _out[_w++] = _a[_i]; \
+            _i++; \
+            _j++; \
+        } \
+        if(_keepA) { \
+            memcpy(_out + _w, _a + _i, (_na - _i) * sizeof(type)); \
+            _w += _na - _i; \
+        } \
+        if(_keepB) { \
+            memcpy(_out + _w, _b + _j, (_nb - _j) * sizeof(type)); \
+            _w += _nb - _j; \
+        } \
+        return _w; \
+    } \
+    static inline type* _vec_priv_setOperation_##suffix(const type* _a, const type* _b, type** _outPtr, \
+            int _keepA, int _keepB, int _keepBoth) { \
+        size_t _na = vec_size(_a), _nb = vec_size(_b); \
+        size_t _max = (_keepA ? _na : 0) + (_keepB ? _nb : 0); \
+        if(_keepBoth && !_keepA && !_keepB) _max = _na < _nb ? _na : _nb; \
+        type* _out = _vec_priv_outputArray((void**)_outPtr, sizeof(type), _max); \
+        if(_out == NULL) return NULL; \
+        _vec_priv_truncate(_out, _vec_priv_setMerge_##suffix(_a, _na, _b, _nb, _out, _keepA, _keepB, _keepBoth)); \
+        return _out; \
+    } \
+    type* vec_setUnion_##suffix(const type* _a, const type* _b, type** _outPtr) { \
+        return _vec_priv_setOperation_##suffix(_a, _b, _outPtr, 1, 1, 1); \
+    } \
+    type* vec_setIntersection_##suffix(const type* _a, const type* _b, type** _outPtr) { \
+        return _vec_priv_setOperation_##suffix(_a, _b, _outPtr, 0, 0, 1); \
+    } \
+    type* vec_setDifference_##suffix(const type* _a, const type* _b, type** _outPtr) { \
+        return _vec_priv_setOperation_##suffix(_a, _b, _outPtr, 1, 0, 0); \
+    } \
+    type* vec_setSymmetricDifference_##suffix(const type* _a, const type* _b, type** _outPtr) { \
+        return _vec_priv_setOperation_##suffix(_a, _b, _outPtr, 1, 1, 0); \
+    } \
+    int vec_setIncludes_##suffix(const type* _a, const type* _b) { \
+        size_t _na = vec_size(_a), _nb = vec_size(_b); \
+        int _gallop = _na / VEC_SET_GALLOP_RATIO >= _nb; \
+        size_t _i = 0; \
+        for(size_t _j = 0; _j < _nb; _j++, _i++) { \
+            _i += _vec_priv_setSkip_##suffix(_a + _i, _na - _i, _b[_j], _gallop); \
+            if(_i == _na || _vec_priv_less_##suffix(_b[_j], _a[_i])) return 0; \
+        } \
+        return 1; \
+    } \
+    size_t vec_unique_##suffix(type** _vecPtr) { \
+        if(_vecPtr == NULL || *_vecPtr == NULL) return 0; \
+        type* _vec = *_vecPtr; \
+        size_t _size = vec_size(_vec), _write = _size > 0; \
+        for(size_t _i = 1; _i < _size; _i++) { \
+            if(_vec_priv_less_##suffix(_vec[_write - 1], _vec[_i]) \
+                    || _vec_priv_less_##suffix(_vec[_i], _vec[_write - 1])) { \
+                _vec[_write++] = _vec[_i]; \
+            } \
+        } \
+        _vec_priv_eraseRange((void**)_vecPtr, _write, _size); \
+        return _size - _write; \
+    }
+
+// number of children of each node of the heaps defined by VEC_DEF_HEAP,
+// with 4 the heap is half as deep as a binary one, and the children of a node, which are next to each other,
+// are often in the same cache line
+#define VEC_HEAP_ARITY 4
+
+/**
+ * define priority queue functions on an array used as a heap, with arity children per node
+ * lessExpr is an expression using a and b (of the given type) that is true if a < b, the top of the heap
+ * is the smallest element, so use a > b for a max heap.
+ * exemple: VEC_DEF_HEAP_ARITY(timer_t, timer, a.deadline < b.deadline, 2)
+ * vec_heapify_##suffix(vec): reorder the array as a heap, in O(n)
+ * vec_heapPush_##suffix(vecPtr, value): add an element, in O(log(n))
+ * vec_heapPushN_##suffix(vecPtr, values, count): add count elements, the array grows once,
+ * and the whole heap is rebuilt when count is big compared to its size
+ * vec_heapPop_##suffix(vecPtr): remove the smallest element and return it, the heap can't be empty
+ * vec_heapTop_##suffix(vec): return the smallest element, the heap can't be empty
+ * vec_isHeap_##suffix(vec): true if the array is a heap
+ * the heap is a normal array, so vec_size(), vec_clear() and vec_foreach() (in no specific order) work on it.
+ * like map functions, they are not inlined, so define them in only one file.
+ */
+#define VEC_DEF_HEAP_ARITY(type, suffix, lessExpr, arity) \
+    static inline int _vec_priv_heapLess_##suffix(type a, type b) { \
+        return (lessExpr); \
+    } \
+    /* move value up from the hole at i */ \
+    static void _vec_priv_heapSiftUp_##suffix(type* _arr, size_t _i, type _value) { \
+        while(_i > 0) { \
+            size_t _parent = (_i - 1) / (arity); \
+            if(!_vec_priv_heapLess_##suffix(_value, _arr[_parent])) break; \
+            _arr[_i] = _arr[_parent]; \
+            _i = _parent; \
+        } \
+        _arr[_i] = _value; \
+    } \
+    /* smallest child of i, i need to have at least one child */ \
+    static inline size_t _vec_priv_heapMinChild_##suffix(const type* _arr, size_t _n, size_t _i) { \
+        size_t _first = (arity) * _i + 1; \
+        size_t _last = _first + (arity) < _n ? _first + (arity) : _n; \
+        /* the children of the first child are the next ones to be read */ \
+        __builtin_prefetch(_arr + (arity) * _first + 1); \
+        size_t _min = _first; \
+        for(size_t _c = _first + 1; _c < _last; _c++) { \
+            if(_vec_priv_heapLess_##suffix(_arr[_c], _arr[_min])) _min = _c; \
+        } \
+        return _min; \
+    } \
+    /* move value down from the hole at i */ \
+    static void _vec_priv_heapSiftDown_##suffix(type* _arr, size_t _n, size_t _i, type _value) { \
+        while((arity) * _i + 1 < _n) { \
+            size_t _child = _vec_priv_heapMinChild_##suffix(_arr, _n, _i); \
+            if(!_vec_priv_heapLess_##suffix(_arr[_child], _value)) break; \
+            _arr[_i] = _arr[_child]; \
+            _i = _child; \
+        } \
+        _arr[_i] = _value; \
+    } \
+    void vec_heapify_##suffix(type* _vec) { \
+        size_t _n = vec_size(_vec); \
+        if(_n < 2) return; \
+        for(size_t _i = (_n - 2) / (arity) + 1; _i-- > 0;) { \
+            _vec_priv_heapSiftDown_##suffix(_vec, _n, _i, _vec[_i]); \
+        } \
+    } \
+    void vec_heapPush_##suffix(type** _vecPtr, type _value) { \
+        if(_vecPtr == NULL || *_vecPtr == NULL) return; \
+        _vec_priv_pushBack((void**)_vecPtr, &_value); \
+        _vec_priv_heapSiftUp_##suffix(*_vecPtr, vec_size(*_vecPtr) - 1, _value); \
+    } \
+    void vec_heapPushN_##suffix(type** _vecPtr, const type* _values, size_t _count) { \
+        if(_vecPtr == NULL || *_vecPtr == NULL || _count == 0) return; \
+        size_t _start = vec_size(*_vecPtr); \
+        _vec_priv_pushBackN((void**)_vecPtr, _values, _count); \
+        /* pushing each element is O(count * log(n)), rebuilding is O(n) */ \
+        if(_count > _start / 4) { \
+            vec_heapify_##suffix(*_vecPtr); \
+            return; \
+        } \
+        for(size_t _i = _start; _i < _start + _count; _i++) { \
+            _vec_priv_heapSiftUp_##suffix(*_vecPtr, _i, (*_vecPtr)[_i]); \
+        } \
+    } \
+    type vec_heapTop_##suffix(const type* _vec) { \
+        return _vec[0]; \
+    } \
+    type vec_heapPop_##suffix(type** _vecPtr) { \
+        type* _arr = *_vecPtr; \
+        type _top = _arr[0]; \
+        type _last; \
+        _vec_priv_popBack((void**)_vecPtr, &_last); \
+        _arr = *_vecPtr; \
+        size_t _n = vec_size(_arr); \
+        if(_n == 0) return _top; \
+        /* the last element goes back near the bottom most of the time, so move the hole down */ \
+        /* to a leaf without comparing it, then move it up from there (fewer comparisons) */ \
+        size_t _i = 0; \
+        while((arity) * _i + 1 < _n) { \
+            size_t _child = _vec_priv_heapMinChild_##suffix(_arr, _n, _i); \
+            _arr[_i] = _arr[_child]; \
+            _i = _child; \
+        } \
+        _vec_priv_heapSiftUp_##suffix(_arr, _i, _last); \
+        return _top; \
+    } \
+    int vec_isHeap_##suffix(const type* _vec) { \
+        size_t _n = vec_size(_vec); \
+        for(size_t _i = 1; _i < _n; _i++) { \
+            if(_vec_priv_heapLess_##suffix(_vec[_i], _vec[(_i - 1) / (arity)])) return 0; \
+        } \
+        return 1; \
+    }
+
+// VEC_DEF_HEAP_ARITY with VEC_HEAP_ARITY children per node
+#define VEC_DEF_HEAP(type, suffix, lessExpr) VEC_DEF_HEAP_ARITY(type, suffix, lessExpr, VEC_HEAP_ARITY)
+
+// under this number of elements, the sort functions defined by VEC_DEF_RADIXSORT use an insertion sort
+#define VEC_RADIXSORT_THRESHOLD 64
+
+// 1 if the type of x can be a key of a radix sort, -1 else
+#define _vec_priv_radixKeySupported(x) _Generic((x), \
+    float: 1, double: 1, _Bool: 1, char: 1, signed char: 1, unsigned char: 1, \
+    short: 1, unsigned short: 1, int: 1, unsigned int: 1, \
+    long: 1, unsigned long: 1, long long: 1, unsigned long long: 1, \
+    default: -1)
+
+// convert a key to an unsigned integer with the same ordering, for radix sorts
+// signed integers have their sign bit flipped, negative floats have all their bits flipped
+// other key types (long double, pointers...) don't compile, the error is a negative width
+// in the bit-field _vec_priv_radixKey_unsupported_type
+#define _vec_priv_radixKey(x) \
+    ((void)sizeof(struct { int _vec_priv_radixKey_unsupported_type : _vec_priv_radixKeySupported(x); }), \
+    _Generic((x), \
+    float: _vec_priv_radixKey_float(x), \
+    double: _vec_priv_radixKey_double(x), \
+    char: ((char)-1 < 0 ? _vec_priv_radixKey_signed(x, sizeof(x)) : (uint64_t)(x)), \
+    signed char: _vec_priv_radixKey_signed(x, sizeof(x)), \
+    short: _vec_priv_radixKey_signed(x, sizeof(x)), \
+    int: _vec_priv_radixKey_signed(x, sizeof(x)), \
+    long: _vec_priv_radixKey_signed(x, sizeof(x)), \
+    long long: _vec_priv_radixKey_signed(x, sizeof(x)), \
+    _Bool: (uint64_t)(x), \
+    unsigned char: (uint64_t)(x), \
+    unsigned short: (uint64_t)(x), \
+    unsigned int: (uint64_t)(x), \
+    unsigned long: (uint64_t)(x), \
+    unsigned long long: (uint64_t)(x), \
+    default: (uint64_t)0))
+
+inline uint64_t _vec_priv_radixKey_signed(long long x, size_t size) {
+    uint64_t mask = size >= 8 ? ~(uint64_t)0 : (((uint64_t)1 << (size * 8)) - 1);
+    return ((uint64_t)x ^ ((uint64_t)1 << (size * 8 - 1))) & mask;
+}
+
+inline uint64_t _vec_priv_radixKey_float(float x) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : bits ^ 0x80000000u;
+}
+
+inline uint64_t _vec_priv_radixKey_double(double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x8000000000000000ull) ? ~bits : bits ^ 0x8000000000000000ull;
+}
+
+// define a stable radix sort for the given type, vec_radixSort_##suffix(vec) and vec_view_radixSort_##suffix(view)
+// keyExpr is an expression using a (of the given type) that give the key to sort on,
+// it can be any integer type, float or double, exemple: VEC_DEF_RADIXSORT(point_t, point, a.x)
+// it's a LSD radix sort, 1 pass per byte of the key, passes where all keys have the same byte are skipped
+// it need a buffer of the size of the array, the unused space at the end of the array (the parent for views)
+// is used if it's big enough,
+// else a buffer is allocated with the allocator of the library,
+// if that fail too, the array is sorted in place with a heapsort on the keys (not stable)
+// being stable, sorting on multiple keys can be done by sorting on the least important key first
+// small arrays are sorted with an insertion sort.
+// like map functions, they are not inlined, so define them in only one file.
+#define VEC_DEF_RADIXSORT(type, suffix, keyExpr) \
+    static inline uint64_t _vec_priv_radixKeyOf_##suffix(type a) { \
+        return _vec_priv_radixKey(keyExpr); \
+    } \
+    static inline size_t _vec_priv_radixKeySizeOf_##suffix(type a) { \
+        return sizeof(keyExpr); \
+    } \
+    void _vec_priv_radixInsertionSort_##suffix(type* _arr, size_t _n) { \
+        for(size_t _i = 1; _i < _n; _i++) { \
+            type _val = _arr[_i]; \
+            uint64_t _key = _vec_priv_radixKeyOf_##suffix(_val); \
+            size_t _j = _i; \
+            while(_j > 0 && _key < _vec_priv_radixKeyOf_##suffix(_arr[_j - 1])) { \
+                _arr[_j] = _arr[_j - 1]; \
+                _j--; \
+            } \
+            _arr[_j] = _val; \
+        } \
+    } \
+    void _vec_priv_radixSiftDown_##suffix(type* _arr, size_t _i, size_t _n) { \
+        type _val = _arr[_i]; \
+        uint64_t _key = _vec_priv_radixKeyOf_##suffix(_val); \
+        while(2 * _i + 1 < _n) { \
+            size_t _child = 2 * _i + 1; \
+            uint64_t _childKey = _vec_priv_radixKeyOf_##suffix(_arr[_child]); \
+            if(_child + 1 < _n) { \
+                uint64_t _rightKey = _vec_priv_radixKeyOf_##suffix(_arr[_child + 1]); \
+                if(_childKey < _rightKey) { \
+                    _child++; \
+                    _childKey = _rightKey; \
+                } \
+            } \
+            if(_childKey <= _key) break; \
+            _arr[_i] = _arr[_child]; \
+            _i = _child; \
+        } \
+        _arr[_i] = _val; \
+    } \
+    /* O(n log(n)) in place sort on the keys, when there is no buffer for the radix sort */ \
+    void _vec_priv_radixHeapSort_##suffix(type* _arr, size_t _n) { \
+        for(size_t _i = _n / 2; _i-- > 0;) { \
+            _vec_priv_radixSiftDown_##suffix(_arr, _i, _n); \
+        } \
+        for(size_t _end = _n - 1; _end > 0; _end--) { \
+            type _tmp = _arr[0]; \
+            _arr[0] = _arr[_end]; \
+            _arr[_end] = _tmp; \
+            _vec_priv_radixSiftDown_##suffix(_arr, 0, _end); \
+        } \
+    } \
+    void _vec_priv_radixSortN_##suffix(const void* _owner, type* _vec, size_t _n) { \
+        if(_n < VEC_RADIXSORT_THRESHOLD) { \
+            _vec_priv_radixInsertionSort_##suffix(_vec, _n); \
+            return; \
+        } \
+        type* _scratch = _vec_priv_scratch(_owner, _n); \
+        if(_scratch == NULL) { \
+            _vec_priv_radixHeapSort_##suffix(_vec, _n); \
+            return; \
+        } \
+        size_t _bytes = _vec_priv_radixKeySizeOf_##suffix(_vec[0]); \
+        size_t _count[sizeof(uint64_t)][256]; \
+        memset(_count, 0, sizeof(_count)); \
+        /* count all the passes at once */ \
+        for(size_t _i = 0; _i < _n; _i++) { \
+            uint64_t _key = _vec_priv_radixKeyOf_##suffix(_vec[_i]); \
+            for(size_t _b = 0; _b < _bytes; _b++) { \
+                _count[_b][(_key >> (_b * 8)) & 0xff]++; \
+            } \
+        } \
+        type* _from = _vec; \
+        type* _to = _scratch; \
+        for(size_t _b = 0; _b < _bytes; _b++) { \
+            /* all keys have the same byte, nothing to do */ \
+            if(_count[_b][(_vec_priv_radixKeyOf_##suffix(_from[0]) >> (_b * 8)) & 0xff] == _n) continue; \
+            size_t _sum = 0; \
+            for(size_t _d = 0; _d < 256; _d++) { \
+                size_t _c = _count[_b][_d]; \
+                _count[_b][_d] = _sum; \
+                _sum += _c; \
+            } \
+            for(size_t _i = 0; _i < _n; _i++) { \
+                _to[_count[_b][(_vec_priv_radixKeyOf_##suffix(_from[_i]) >> (_b * 8)) & 0xff]++] = _from[_i]; \
+            } \
+            type* _tmp = _from; \
+            _from = _to; \
+            _to = _tmp; \
+        } \
+        if(_from != _vec) memcpy(_vec, _from, _n * sizeof(type)); \
+        _vec_priv_scratchFree(_owner, _scratch); \
+    } \
+    void vec_radixSort_##suffix(type* _vec) { \
+        _vec_priv_radixSortN_##suffix(_vec, _vec, vec_size(_vec)); \
+    } \
+    void vec_view_radixSort_##suffix(vec_view_t _view) { \
+        _vec_priv_radixSortN_##suffix(_view.parent, _view.data, _view.size); \
+    }
+
+// double ended queue, see vec_deque_create()
+typedef struct vec_deque_s vec_deque_t;
+
+// define typed functions for deques (circular buffers), to use for queues instead of
+// pushBack + popFront on arrays, as push and pop at both ends never move the other elements.
+// the deque is not an array, elements are accessed with vec_deque_at_##suffix(dq, i),
+// it's created with vec_deque_create_##suffix(capacity) and freed with vec_deque_free()
+// popFrontN remove up to count elements from the front into buff, and return how many were removed
+#define VEC_DEF_DEQUE(type, suffix) \
+    inline vec_deque_t* vec_deque_create_##suffix(size_t _capacity) { \
+        return vec_deque_create(sizeof(type), _capacity); \
+    } \
+    inline void vec_deque_pushBack_##suffix(vec_deque_t* _dq, type _value) { \
+        _vec_priv_deque_pushBack(_dq, &_value); \
+    } \
+    inline void vec_deque_pushFront_##suffix(vec_deque_t* _dq, type _value) { \
+        _vec_priv_deque_pushFront(_dq, &_value); \
+    } \
+    inline type vec_deque_popBack_##suffix(vec_deque_t* _dq) { \
+        type _buff; \
+        _vec_priv_deque_popBack(_dq, &_buff); \
+        return _buff; \
+    } \
+    inline type vec_deque_popFront_##suffix(vec_deque_t* _dq) { \
+        type _buff; \
+        _vec_priv_deque_popFront(_dq, &_buff); \
+        return _buff; \
+    } \
+    inline void vec_deque_pushBackN_##suffix(vec_deque_t* _dq, const type* _values, size_t _count) { \
+        _vec_priv_deque_pushBackN(_dq, _values, _count); \
+    } \
+    inline size_t vec_deque_popFrontN_##suffix(vec_deque_t* _dq, type* _buff, size_t _count) { \
+        return _vec_priv_deque_popFrontN(_dq, _buff, _count); \
+    } \
+    inline type* vec_deque_at_##suffix(vec_deque_t* _dq, size_t _index) { \
+        return (type*)_vec_priv_deque_at(_dq, _index); \
+    }
+
+// segmented array, see vec_segvec_create()
+typedef struct vec_segvec_s vec_segvec_t;
+
+// define typed functions for segmented arrays, to use instead of arrays when the elements
+// must not move: the elements are stored in fixed size chunks that are never reallocated,
+// so pushBack never copy the existing elements and their addresses stay valid until they are popped.
+// elements are accessed with vec_segvec_at_##suffix(sv, i) (O(1)), or chunk by chunk with
+// vec_segvec_chunk_##suffix(sv, chunkIndex, &count), which return NULL after the last chunk:
+// for(size_t c = 0; (chunk = vec_segvec_chunk_int(sv, c, &count)) != NULL; c++) ...
+// pushBack return the address of the new element (NULL if the allocation failed)
+// it's created with vec_segvec_create_##suffix(chunkSize) and freed with vec_segvec_free()
+#define VEC_DEF_SEGVEC(type, suffix) \
+    inline vec_segvec_t* vec_segvec_create_##suffix(size_t _chunkSize) { \
+        return vec_segvec_create(sizeof(type), _chunkSize); \
+    } \
+    inline type* vec_segvec_pushBack_##suffix(vec_segvec_t* _sv, type _value) { \
+        return (type*)_vec_priv_segvec_pushBack(_sv, &_value); \
+    } \
+    inline type vec_segvec_popBack_##suffix(vec_segvec_t* _sv) { \
+        type _buff; \
+        _vec_priv_segvec_popBack(_sv, &_buff); \
+        return _buff; \
+    } \
+    inline void vec_segvec_pushBackN_##suffix(vec_segvec_t* _sv, const type* _values, size_t _count) { \
+        _vec_priv_segvec_pushBackN(_sv, _values, _count); \
+    } \
+    inline type* vec_segvec_at_##suffix(const vec_segvec_t* _sv, size_t _index) { \
+        return (type*)_vec_priv_segvec_at(_sv, _index); \
+    } \
+    inline type* vec_segvec_chunk_##suffix(const vec_segvec_t* _sv, size_t _chunkIndex, size_t* _count) { \
+        return (type*)_vec_priv_segvec_chunk(_sv, _chunkIndex, _count); \
+    }
+
+// number of slots whose metadata are checked at once by the hash maps
+#define VEC_HASH_GROUP 16
+// metadata of the free slots of the hash maps, a used slot has 7 bits of the hash of its key
+#define VEC_HASH_EMPTY 0x80
+#define VEC_HASH_DELETED 0xFE
+
+// final mix of a hash (from murmur3), so that all bits of the hash depends on all bits of the key
+inline uint64_t _vec_priv_hashMix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// bit i is set if the metadata i of the group is h2 (with SSE2 all the group is compared at once)
+inline unsigned _vec_priv_hashMatch(const uint8_t* group, uint8_t h2) {
+#ifdef __SSE2__
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+#else
+    unsigned mask = 0;
+    for(unsigned i = 0; i < VEC_HASH_GROUP; i++) mask |= (unsigned)(group[i] == h2) << i;
+    return mask;
+#endif
+}
+
+// bit i is set if the slot i of the group is free (empty or deleted, the only metadata with the high bit set)
+inline unsigned _vec_priv_hashMatchFree(const uint8_t* group) {
+#ifdef __SSE2__
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+    unsigned mask = 0;
+    for(unsigned i = 0; i < VEC_HASH_GROUP; i++) mask |= (unsigned)(group[i] >> 7) << i;
+    return mask;
+#endif
+}
+
+/**
+ * define a hash map from keyType to valueType, vec_hashmap_##suffix##_t, and its functions.
+ * the slots are in a flat array, with one byte of metadata per slot (7 bits of the hash, or empty/deleted),
+ * a lookup compare the metadata of a group of 16 slots at once (with SSE2), and only compare the keys
+ * of the slots with the same 7 bits, the groups are probed one after the other (quadratic probing).
+ * the metadata and the slots are arrays of the library, created with the allocator given to vec_hashmap_init_##suffix,
+ * the number of slots is a power of 2, doubled when 7/8 of them are used.
+ * hashFn is called as hashFn(key) and return an integer, it is mixed by the map so even the identity is fine for integers,
+ * see vec_hash_bytes() and vec_hash_string() for other keys.
+ * eqExpr is an expression using a and b (two keys), true if they are equal.
+ * exemple: VEC_DEF_HASHMAP(const char*, int, strint, vec_hash_string, strcmp(a, b) == 0)
+ *
+ * vec_hashmap_init_##suffix(map, allocator): init an empty map (NULL for the allocator of the library), nothing is allocated
+ * vec_hashmap_free_##suffix(map): free the memory of the map, which is left empty
+ * vec_hashmap_reserve_##suffix(map, count): make room for count keys, return 0 if the allocation failed
+ * vec_hashmap_insert_##suffix(map, key, value): set the value of key, return the address of the value in the map
+ * (NULL if the allocation failed)
+ * vec_hashmap_find_##suffix(map, key): return the address of the value of key, NULL if it's not in the map
+ * vec_hashmap_erase_##suffix(map, key): remove the key, return 0 if it wasn't in the map
+ * vec_hashmap_size_##suffix(map): number of keys in the map
+ * vec_hashmap_clear_##suffix(map): remove all the keys, keeping the memory
+ * vec_hashmap_next_##suffix(map, &iter): iterate on the entries (key and value) of the map, iter need to start at 0,
+ * return NULL after the last entry
+ * the addresses returned are valid until the next insert or reserve (the slots can be moved when the map grows).
+ * like map functions, they are not inlined, so define them in only one file.
+ */
+#define VEC_DEF_HASHMAP(keyType, valueType, suffix, hashFn, eqExpr) \
+    typedef struct { \
+        keyType key; \
+        valueType value; \
+    } vec_hashmap_entry_##suffix##_t; \
+    typedef struct { \
+        uint8_t* ctrl; /* metadata of the slots */ \
+        vec_hashmap_entry_##suffix##_t* entries; /* slots */ \
+        size_t size; /* number of keys */ \
+        size_t deleted; /* deleted slots, reused by inserts or cleaned when the map is rehashed */ \
+        const vec_allocator_t* allocator; \
+    } vec_hashmap_##suffix##_t; \
+    static inline int _vec_priv_hashEq_##suffix(keyType a, keyType b) { \
+        return (eqExpr); \
+    } \
+    static inline uint64_t _vec_priv_hash_##suffix(keyType _key) { \
+        return _vec_priv_hashMix((uint64_t)(hashFn(_key))); \
+    } \
+    /* slot of key, or the number of slots if it's not in the map */ \
+    static size_t _vec_priv_hashFind_##suffix(const vec_hashmap_##suffix##_t* _map, keyType _key, uint64_t _hash) { \
+        size_t _cap = vec_size(_map->ctrl); \
+        if(_cap == 0) return 0; \
+        size_t _groupMask = _cap / VEC_HASH_GROUP - 1; \
+        size_t _group = (_hash >> 7) & _groupMask; \
+        for(size_t _step = 1; ; _step++) { \
+            const uint8_t* _ctrl = _map->ctrl + _group * VEC_HASH_GROUP; \
+            unsigned _match = _vec_priv_hashMatch(_ctrl, _hash & 0x7F); \
+            while(_match) { \
+                size_t _slot = _group * VEC_HASH_GROUP + __builtin_ctz(_match); \
+                if(_vec_priv_hashEq_##suffix(_map->entries[_slot].key, _key)) return _slot; \
+                _match &= _match - 1; \
+            } \
+            /* an insert would have used an empty slot of this group */ \
+            if(_vec_priv_hashMatch(_ctrl, VEC_HASH_EMPTY)) return _cap; \
+            _group = (_group + _step) & _groupMask; \
+        } \
+    } \
+    /* first free slot of the groups probed for hash, there is always one as the map is never full */ \
+    static size_t _vec_priv_hashFree_##suffix(const vec_hashmap_##suffix##_t* _map, uint64_t _hash) { \
+        size_t _groupMask = vec_size(_map->ctrl) / VEC_HASH_GROUP - 1; \
+        size_t _group = (_hash >> 7) & _groupMask; \
+        for(size_t _step = 1; ; _step++) { \
+            unsigned _free = _vec_priv_hashMatchFree(_map->ctrl + _group * VEC_HASH_GROUP); \
+            if(_free) return _group * VEC_HASH_GROUP + __builtin_ctz(_free); \
+            _group = (_group + _step) & _groupMask; \
+        } \
+    } \
+    /* move the entries to new arrays of capacity slots */ \
+    static int _vec_priv_hashRehash_##suffix(vec_hashmap_##suffix##_t* _map, size_t _capacity) { \
+        uint8_t* _ctrl = vec_create_with_allocator(1, _capacity, _map->allocator); \
+        vec_hashmap_entry_##suffix##_t* _entries = \
+            vec_create_with_allocator(sizeof(vec_hashmap_entry_##suffix##_t), _capacity, _map->allocator); \
+        if(_ctrl == NULL || _entries == NULL) { \
+            vec_free(_ctrl); \
+            vec_free(_entries); \
+            return 0; \
+        } \
+        memset(_ctrl, VEC_HASH_EMPTY, _capacity); \
+        vec_hashmap_##suffix##_t _old = *_map; \
+        _map->ctrl = _ctrl; \
+        _map->entries = _entries; \
+        _map->deleted = 0; \
+        for(size_t _i = 0; _i < vec_size(_old.ctrl); _i++) { \
+            if(_old.ctrl[_i] & VEC_HASH_EMPTY) continue; \
+            uint64_t _hash = _vec_priv_hash_##suffix(_old.entries[_i].key); \
+            size_t _slot = _vec_priv_hashFree_##suffix(_map, _hash); \
+            _ctrl[_slot] = _hash & 0x7F; \
+            _entries[_slot] = _old.entries[_i]; \
+        } \
+        vec_free(_old.ctrl); \
+        vec_free(_old.entries); \
+        return 1; \
+    } \
+    void vec_hashmap_init_##suffix(vec_hashmap_##suffix##_t* _map, const vec_allocator_t* _allocator) { \
+        _map->ctrl = NULL; \
+        _map->entries = NULL; \
+        _map->size = 0; \
+        _map->deleted = 0; \
+        _map->allocator = _allocator; \
+    } \
+    void vec_hashmap_free_##suffix(vec_hashmap_##suffix##_t* _map) { \
+        vec_free(_map->ctrl); \
+        vec_free(_map->entries); \
+        vec_hashmap_init_##suffix(_map, _map->allocator); \
+    } \
+    size_t vec_hashmap_size_##suffix(const vec_hashmap_##suffix##_t* _map) { \
+        return _map->size; \
+    } \
+    int vec_hashmap_reserve_##suffix(vec_hashmap_##suffix##_t* _map, size_t _count) { \
+        size_t _capacity = VEC_HASH_GROUP; \
+        while(_capacity / 8 * 7 < _count) _capacity *= 2; \
+        if(_capacity <= vec_size(_map->ctrl)) return 1; \
+        return _vec_priv_hashRehash_##suffix(_map, _capacity); \
+    } \
+    valueType* vec_hashmap_insert_##suffix(vec_hashmap_##suffix##_t* _map, keyType _key, valueType _value) { \
+        uint64_t _hash = _vec_priv_hash_##suffix(_key); \
+        size_t _cap = vec_size(_map->ctrl); \
+        size_t _slot = _vec_priv_hashFind_##suffix(_map, _key, _hash); \
+        if(_slot < _cap) { \
+            _map->entries[_slot].value = _value; \
+            return &_map->entries[_slot].value; \
+        } \
+        if(_map->size + _map->deleted + 1 > _cap / 8 * 7) { \
+            /* if the deleted slots make most of the load, rehash at the same size to clean them */ \
+            size_t _newCap = _cap == 0 ? VEC_HASH_GROUP : _map->size + 1 > _cap / 16 * 7 ? _cap * 2 : _cap; \
+            if(!_vec_priv_hashRehash_##suffix(_map, _newCap)) return NULL; \
+        } \
+        _slot = _vec_priv_hashFree_##suffix(_map, _hash); \
+        if(_map->ctrl[_slot] == VEC_HASH_DELETED) _map->deleted--; \
+        _map->ctrl[_slot] = _hash & 0x7F; \
+        _map->entries[_slot].key = _key; \
+        _map->entries[_slot].value = _value; \
+        _map->size++; \
+        return &_map->entries[_slot].value; \
+    } \
+    valueType* vec_hashmap_find_##suffix(const vec_hashmap_##suffix##_t* _map, keyType _key) { \
+        size_t _slot = _vec_priv_hashFind_##suffix(_map, _key, _vec_priv_hash_##suffix(_key)); \
+        return _slot < vec_size(_map->ctrl) ? &_map->entries[_slot].value : NULL; \
+    } \
+    int vec_hashmap_erase_##suffix(vec_hashmap_##suffix##_t* _map, keyType _key) { \
+        size_t _slot = _vec_priv_hashFind_##suffix(_map, _key, _vec_priv_hash_##suffix(_key)); \
+        if(_slot >= vec_size(_map->ctrl)) return 0; \
+        /* if the group has an empty slot, no lookup go past it, so the slot can be empty too */ \
+        if(_vec_priv_hashMatch(_map->ctrl + (_slot & ~(size_t)(VEC_HASH_GROUP - 1)), VEC_HASH_EMPTY)) { \
+            _map->ctrl[_slot] = VEC_HASH_EMPTY; \
+        } else { \
+            _map->ctrl[_slot] = VEC_HASH_DELETED; \
+            _map->deleted++; \
+        } \
+        _map->size--; \
+        return 1; \
+    } \
+    void vec_hashmap_clear_##suffix(vec_hashmap_##suffix##_t* _map) { \
+        if(_map->ctrl != NULL) memset(_map->ctrl, VEC_HASH_EMPTY, vec_size(_map->ctrl)); \
+        _map->size = 0; \
+        _map->deleted = 0; \
+    } \
+    vec_hashmap_entry_##suffix##_t* vec_hashmap_next_##suffix(const vec_hashmap_##suffix##_t* _map, size_t* _iter) { \
+        size_t _cap = vec_size(_map->ctrl); \
+        while(*_iter < _cap) { \
+            size_t _group = *_iter & ~(size_t)(VEC_HASH_GROUP - 1); \
+            /* used slots of the group, starting at iter */ \
+            unsigned _used = ~_vec_priv_hashMatchFree(_map->ctrl + _group) & (0xFFFFu << (*_iter - _group)) & 0xFFFFu; \
+            if(_used) { \
+                size_t _slot = _group + __builtin_ctz(_used); \
+                *_iter = _slot + 1; \
+                return &_map->entries[_slot]; \
+            } \
+            *_iter = _group + VEC_HASH_GROUP; \
+        } \
+        return NULL; \
+    }
+
+// define vec_removeIf_##suffix(vecPtr, ctx), that remove all elements for which predExpr is true
+// and return the number of removed elements.
+// predExpr is an expression using a (the element) and ctx (the void* given to the function),
+// exemple: VEC_DEF_REMOVE_IF(entry_t, expired, a.deadline < *(time_t*)ctx)
+// the kept elements are compacted in one pass, then the array is shrinked once,
+// see also vec_retain() for a version with a function pointer.
+// like map functions, they are not inlined, so define them in only one file.
+#define VEC_DEF_REMOVE_IF(type, suffix, predExpr) \
+    static inline int _vec_priv_removePred_##suffix(type a, void* ctx) { \
+        return (predExpr); \
+    } \
+    size_t vec_removeIf_##suffix(type** _vecPtr, void* _ctx) { \
+        if(_vecPtr == NULL || *_vecPtr == NULL) return 0; \
+        type* _vec = *_vecPtr; \
+        size_t _size = vec_size(_vec), _write = 0; \
+        for(size_t _i = 0; _i < _size; _i++) { \
+            if(!_vec_priv_removePred_##suffix(_vec[_i], _ctx)) { \
+                _vec[_write++] = _vec[_i]; \
+            } \
+        } \
+        _vec_priv_eraseRange((void**)_vecPtr, _write, _size); \
+        return _size - _write; \
+    }
+
+/**
+ * lazy pipelines: the elements of an array (or a view) go through stages one by one,
+ * and are given to a sink (collect, count, foreach, or a reduce of VEC_DEF_PIPELINE_REDUCE) in the same loop,
+ * so there is no intermediate array whatever the number of stages.
+ * the stages are defined with VEC_DEF_STAGE_MAP, VEC_DEF_STAGE_FILTER and chained with VEC_DEF_STAGE_CHAIN,
+ * then VEC_DEF_PIPELINE define the functions of the pipeline for the last stage:
+ * 
+ * VEC_DEF_STAGE_MAP(int, float, half, a / 2.0f)
+ * VEC_DEF_STAGE_FILTER(float, positive, a > 0)
+ * VEC_DEF_STAGE_CHAIN(int, float, float, positiveHalf, half, positive)
+ * VEC_DEF_PIPELINE(int, float, positiveHalf, positiveHalf)
+ * 
+ * vec_pipe_t pipe = vec_pipe(vec, NULL);
+ * vec_pipe_skip(&pipe, 10);
+ * vec_pipe_take(&pipe, 100);
+ * float* res = vec_pipe_collect_positiveHalf(&pipe, NULL);
+ * 
+ * the expressions of the stages use a (the element) and ctx (the void* given to vec_pipe()).
+ * stage names have their own namespace, they don't collide with the suffixes of the other macros.
+ */
+
+// state of a pipeline, created by vec_pipe() or vec_view_pipe()
+// the source array need to stay unchanged while the pipeline is used
+typedef struct {
+    const void* data; // next element of the source
+    size_t left; // number of elements left in the source
+    size_t skip; // number of outputs still to drop
+    size_t take; // number of outputs still to give
+    void* ctx; // given to the stages
+} vec_pipe_t;
+
+// define a stage converting a fromType to a toType with mapExpr
+#define VEC_DEF_STAGE_MAP(fromType, toType, name, mapExpr) \
+    inline int _vec_stage_##name(fromType a, toType* _out, void* ctx) { \
+        *_out = (mapExpr); \
+        return 1; \
+    }
+
+// define a stage keeping only the elements for which predExpr is true
+#define VEC_DEF_STAGE_FILTER(type, name, predExpr) \
+    inline int _vec_stage_##name(type a, type* _out, void* ctx) { \
+        *_out = a; \
+        return (predExpr); \
+    }
+
+// define a stage running the stage first (fromType to midType), then the stage second (midType to toType)
+// chains can be chained again to make longer pipelines
+#define VEC_DEF_STAGE_CHAIN(fromType, midType, toType, name, first, second) \
+    inline int _vec_stage_##name(fromType _a, toType* _out, void* _ctx) { \
+        midType _mid; \
+        return _vec_stage_##first(_a, &_mid, _ctx) && _vec_stage_##second(_mid, _out, _ctx); \
+    }
+
+// define the functions of a pipeline from a source of fromType, through the stage, to toType:
+// vec_pipe_next_##suffix(pipe, out): write the next output in out and return 1, or return 0 when the pipeline is done
+// vec_pipe_collect_##suffix(pipe, outPtr): push all outputs at the end of *outPtr (or a new array if outPtr or *outPtr is NULL)
+// and return the array
+// vec_pipe_count_##suffix(pipe): return the number of outputs
+// see also vec_pipe_foreach() and VEC_DEF_PIPELINE_REDUCE
+#define VEC_DEF_PIPELINE(fromType, toType, suffix, stage) \
+    inline int vec_pipe_next_##suffix(vec_pipe_t* _pipe, toType* _out) { \
+        while(_pipe->take > 0 && _pipe->left > 0) { \
+            const fromType* _in = _pipe->data; \
+            _pipe->data = _in + 1; \
+            _pipe->left--; \
+            if(!_vec_stage_##stage(*_in, _out, _pipe->ctx)) continue; \
+            if(_pipe->skip > 0) { \
+                _pipe->skip--; \
+                continue; \
+            } \
+            _pipe->take--; \
+            return 1; \
+        } \
+        return 0; \
+    } \
+    inline toType* vec_pipe_collect_##suffix(vec_pipe_t* _pipe, toType** _outPtr) { \
+        toType* _arr = _outPtr != NULL && *_outPtr != NULL ? *_outPtr : vec_create(sizeof(toType), 0); \
+        toType _value; \
+        while(vec_pipe_next_##suffix(_pipe, &_value)) { \
+            _vec_priv_pushBack((void**)&_arr, &_value); \
+        } \
+        if(_outPtr != NULL) *_outPtr = _arr; \
+        return _arr; \
+    } \
+    inline size_t vec_pipe_count_##suffix(vec_pipe_t* _pipe) { \
+        size_t _count = 0; \
+        toType _value; \
+        while(vec_pipe_next_##suffix(_pipe, &_value)) _count++; \
+        return _count; \
+    }
+
+// define vec_pipe_reduce_##name(pipe, init), that fold the outputs of the pipeline of the given suffix
+// (outputs of type) into an accType, starting from init, with foldExpr using acc (the accumulator),
+// a (the output) and ctx (the ctx of the pipeline). the fold is inlined in the loop of the pipeline.
+// exemple: VEC_DEF_PIPELINE_REDUCE(float, double, positiveHalf, positiveHalfSum, acc + a)
+#define VEC_DEF_PIPELINE_REDUCE(type, accType, suffix, name, foldExpr) \
+    inline accType vec_pipe_reduce_##name(vec_pipe_t* _pipe, accType _init) { \
+        accType acc = _init; \
+        void* ctx = _pipe->ctx; \
+        type a; \
+        while(vec_pipe_next_##suffix(_pipe, &a)) { \
+            acc = (foldExpr); \
+        } \
+        (void)ctx; \
+        return acc; \
+    }
+
+// run loop for each output of the pipeline, val being the output (like vec_foreach)
+// pipe is the vec_pipe_t variable itself (not a pointer), it is advanced in place and is empty after the loop,
+// suffix is the suffix of its VEC_DEF_PIPELINE
+#define vec_pipe_foreach(pipe, suffix, type, val, loop) \
+    { \
+        type val; \
+        while(vec_pipe_next_##suffix(&(pipe), &val)) { \
+            loop \
+        } \
+    }
+
+// for next 2 functions, put the loop in a new block to scope the val variable
+
+// foreach emulations, can be used like:
+// vec_foreach(vec, int, i, val, 
+//     printf("%d\n", val);
+// )
+// val is the value of the current element
+// iter is the index iterator, contain index of current element
+// the size of the array is read once, before the loop
+#define vec_foreach(vec, type, iter, val, loop) \
+    { \
+        type val; \
+        size_t _vec_size_##iter = vec_size(vec); \
+        for(size_t iter = 0; iter < _vec_size_##iter; iter++) {\
+            val = vec[iter]; \
+            loop \
+        } \
+    }
+
+// same as vec_foreach, but in reverse order
+#define vec_foreach_reverse(vec, type, iter, val, loop) \
+    { \
+        type val; \
+        for(size_t iter = vec_size(vec); iter-- > 0;) {\
+            val = vec[iter]; \
+            loop \
+        } \
+    }
+
+// define wrappers for compare function to be used with either bsearch or qsort
+// not inlined (for obvious reasons)
+#define DYNNAR_COMPARE_FN(type, suffix, compareFn) \
+    int vec_compare_##suffix(const void* a, const void* b) { \
+        return compareFn(*(type*)a, *(type*)b); \
+    }
+
+
+
+
+// value for the shrinkRatio parameter of vec_setPolicy(), the array will never shrink
+#define VEC_SHRINK_NEVER 0
+// default policy of new arrays: double the capacity when full,
+// shrink it when less than a quarter is used
+#define VEC_DEFAULT_GROWTH 200
+#define VEC_DEFAULT_SHRINK 4
+
+// public functions
+
+// create a new array of elements of size memSize and of min-size size
+// array will be of the given size, if you init it of size 10, every push will append after the 10th element
+// if you want to pre allocate memory, init with size 0 and use preAllocate() function
+void* vec_create(size_t memSize, size_t size);
+// same as vec_create(), but the memory of the array come from the given allocator (see vec_allocator_t)
+// NULL use the allocator of the library
+void* vec_create_with_allocator(size_t memSize, size_t size, const vec_allocator_t* allocator);
+/**
+ * same as vec_create(), but the first element is always aligned on align bytes (a power of 2, 16, 32, 64...)
+ * the alignment is kept when the array is resized and when elements are added or removed at the front.
+ * if memSize is not a multiple of align, the front can't move by one element without losing the alignment,
+ * so vec_pushFront() and vec_popFront() move all the elements (O(n) instead of O(1))
+ * return NULL if align is not a power of 2
+ */
+void* vec_create_aligned(size_t memSize, size_t size, size_t align);
+// return the size of the array
+size_t vec_size(const void* vec);
+// free the array
+void vec_free(void* vec);
+/**
+ * sort the array, 
+ * just a wrapper for qsort
+ * if you plan to sort the array multiple times,
+ * set the comparator function with vec_setComparator() and use vec_sort()
+ */
+void vec_qsort(void* vec, int (*compar_fn) (const void *, const void *));
+// if resize is true :
+// allocate memory for newSize element and set the size to newSize
+// do nothing if newSize is smaller than the current size
+// if resize is false :
+// allocate memory for newSize element but keep the size, allowing to add elements with adding functions
+// without reallocating when place need to be made
+// do nothing if enough memory is already allocated
+// caution: functions that removes elements will automatically resize the array to its min-size
+void vec_allocate(void* vecPtr, size_t newSize, int resize);
+// return the number of elements the array can hold before being resized
+// (the room at the front of the array, left by vec_popFront(), is counted)
+size_t vec_capacity(const void* vec);
+// resize the array to hold exactly its elements, the next push will grow it
+// need the array pointer as parameter, not the array itself
+void vec_shrinkToFit(void* vecPtr);
+// keep only the elements for which keep(element, ctx) return true, and return the number of removed elements
+// need the array pointer as parameter, not the array itself
+// the kept elements are compacted in one pass, then the array is shrinked once
+size_t vec_retain(void* vecPtr, int (*keep)(const void*, void*), void* ctx);
+// reverse the array
+void vec_reverse(void* vec);
+// swap two elements in the array
+void vec_swap(void* vecPtr, size_t index1, size_t index2);
+// overwrite the allocator function of the library, default is malloc
+// on linux, with malloc and free big arrays are mapped directly, and grown with mremap
+void vec_set_allocator(void* (*_allocator)(size_t));
+// overwrite the reallocator function of the library, default is realloc
+// vec_set_allocator() and vec_set_deallocator() disable it, so set it after them
+void vec_set_reallocator(void* (*_reallocator)(void*, size_t));
+// overwrite the deallocator function of the library, default is free
+void vec_set_deallocator(void (*_deallocator)(void*));
+/**
+ * enable the cache of freed blocks of the arrays using the allocator of the library (disabled by default)
+ * each thread keep up to maxBlocks freed blocks per power of 2 size class, and up to maxBytes bytes,
+ * the next arrays created or resized by the thread reuse them without calling the allocator.
+ * blocks bigger than maxBlockSize are never cached, maxBlocks = 0 disable the cache.
+ * the cache of a thread is given back when it exit (or with vec_cache_trim()), but not for the main thread,
+ * vec_set_allocator() and vec_set_deallocator() only trim the cache of the calling thread,
+ * so change them before using the cache in other threads
+ */
+void vec_cache_setLimits(size_t maxBlocks, size_t maxBytes, size_t maxBlockSize);
+// give back the blocks kept by the cache of the calling thread to the allocator of the library
+void vec_cache_trim(void);
+// return the allocator used by the array
+const vec_allocator_t* vec_getAllocator(const void* vec);
+// return the counters of the array, or the global counters if vec is NULL, see vec_stats_t
+vec_stats_t vec_getStats(const void* vec);
+// reset the global counters, the current allocated bytes become the peak
+void vec_resetStats(void);
+// print the counters of the array (or the global ones if vec is NULL) to stream
+void vec_dumpStats(const void* vec, FILE* stream);
+// set a comparator function for the array
+// allowing to use function for sorted arrays
+void vec_setComparator(void* vec, int (*cmp)(const void*, const void*));
+/**
+ * set the growth and shrink policy of the array
+ * growthPercent is the factor applied to the capacity when the array is full (200 = double, 150 = 1.5x),
+ * it's clamped beetween 101 and 10000
+ * the capacity is shrinked to size * shrinkRatio / 2 when size * shrinkRatio <= capacity,
+ * shrinkRatio can't be less than 2, VEC_SHRINK_NEVER disable shrinking (and clear keep the memory)
+ * a ratio bigger than 2 avoid reallocating on every push/pop when the size oscillate around the capacity
+ */
+void vec_setPolicy(void* vec, unsigned growthPercent, unsigned shrinkRatio);
+// sort the array,
+// need the comparator function to be set
+// wrapper for qsort, which is not stable
+void vec_sort(void* vec);
+// sort the array with nthreads threads (rounded down to a power of 2),
+// need the comparator function to be set
+// each thread sort a part of the array with qsort, then the parts are merged in parallel,
+// less threads are used if the parts would be too small
+// need a buffer of the size of the array for the merges, the unused space at the end of the array is used if possible
+void vec_sort_parallel(void* vec, size_t nthreads);
+// return a view of the elements of the array beetween start and end, end excluded
+// out of bounds indexes are clamped to the size of the array, see vec_view_t
+vec_view_t vec_view(const void* vec, size_t start, size_t end);
+// return a view of the elements of the view beetween start and end (relative to the view), end excluded
+vec_view_t vec_view_sub(vec_view_t view, size_t start, size_t end);
+// return a new array containing a copy of the elements of the view, need to be freed with vec_free()
+void* vec_view_toVec(vec_view_t view);
+// sort the elements of the view with qsort and the given comparator
+void vec_view_qsort(vec_view_t view, int (*compar_fn) (const void *, const void *));
+// sort the elements of the view with nthreads threads and the given comparator, see vec_sort_parallel()
+void vec_view_sort_parallel(vec_view_t view, size_t nthreads, int (*cmp)(const void*, const void*));
+// return if the array is sorted
+// need the comparator function to be set
+int vec_isSorted(const void* vec);
+// return a pipeline reading all the elements of the array, ctx is given to the stages, see VEC_DEF_PIPELINE
+vec_pipe_t vec_pipe(const void* vec, void* ctx);
+// return a pipeline reading the elements of the view
+vec_pipe_t vec_view_pipe(vec_view_t view, void* ctx);
+// drop the count next outputs of the pipeline (before the ones limited by vec_pipe_take())
+void vec_pipe_skip(vec_pipe_t* pipe, size_t count);
+// stop the pipeline after count more outputs (not counting the skipped ones)
+void vec_pipe_take(vec_pipe_t* pipe, size_t count);
+// create a pool of nthreads threads for the parallel loops (VEC_DEF_PARALLEL_MAP...), 0 for one per cpu
+// the thread running a loop count as one of them, so nthreads - 1 workers are created,
+// they wait for the loops until the pool is freed with vec_threadPool_free()
+// the pool can be used by several threads, their loops are run one after the other
+vec_threadPool_t* vec_threadPool_create(size_t nthreads);
+// stop the threads and free the pool
+void vec_threadPool_free(vec_threadPool_t* pool);
+// return the number of threads running the loops (the workers and the calling thread), 1 for a NULL pool
+size_t vec_threadPool_size(const vec_threadPool_t* pool);
+
+// create a deque for elements of size memSize with room for at least capacity elements
+// need to be freed with vec_deque_free()
+// the allocated size is a power of 2 and doubles when the deque is full, it never shrink
+vec_deque_t* vec_deque_create(size_t memSize, size_t capacity);
+// free the deque
+void vec_deque_free(vec_deque_t* dq);
+// return the number of elements in the deque
+size_t vec_deque_size(const vec_deque_t* dq);
+// remove all elements of the deque, keeping its memory
+void vec_deque_clear(vec_deque_t* dq);
+
+// create a segmented array for elements of size memSize, stored in chunks of chunkSize elements
+// (rounded up to a power of 2, 0 choose chunks of about 4KB), need to be freed with vec_segvec_free()
+// chunks are allocated when needed and freed when empty (one empty chunk is kept at the end)
+vec_segvec_t* vec_segvec_create(size_t memSize, size_t chunkSize);
+// free the segmented array and all its chunks
+void vec_segvec_free(vec_segvec_t* sv);
+// return the number of elements in the segmented array
+size_t vec_segvec_size(const vec_segvec_t* sv);
+// return the number of elements per chunk
+size_t vec_segvec_chunkSize(const vec_segvec_t* sv);
+// remove all elements of the segmented array, keeping only its first chunk
+void vec_segvec_clear(vec_segvec_t* sv);
+
+// create an arena allocating blocks of blockSize bytes (or more for bigger allocations)
+// the blocks are allocated with the allocator of the library, need to be freed with vec_arena_free()
+vec_arena_t* vec_arena_create(size_t blockSize);
+// return the allocator to give to vec_create_with_allocator(), valid as long as the arena
+const vec_allocator_t* vec_arena_allocator(vec_arena_t* arena);
+// free all allocations of the arena at once, keeping the blocks for the next allocations
+// all arrays created with the arena are invalidated, don't call vec_free() on them
+void vec_arena_reset(vec_arena_t* arena);
+// free the arena and all its blocks
+void vec_arena_free(vec_arena_t* arena);
+// create a pool allocator, need to be freed with vec_pool_free()
+vec_pool_t* vec_pool_create(void);
+// return the allocator to give to vec_create_with_allocator(), valid as long as the pool
+const vec_allocator_t* vec_pool_allocator(vec_pool_t* pool);
+// free the pool and all the memory it kept, the arrays using the pool need to be freed before
+void vec_pool_free(vec_pool_t* pool);
+
+// hash of size bytes (FNV-1a), to use as hashFn of VEC_DEF_HASHMAP for keys that aren't integers
+uint64_t vec_hash_bytes(const void* data, size_t size);
+// hash of a null terminated string
+uint64_t vec_hash_string(const char* str);
+
+// private functions
+void _vec_priv_pushBack(void** vecPtr, void* value);
+void _vec_priv_pushFront(void** vecPtr, void* value);
+void _vec_priv_pushBackN(void** vecPtr, const void* values, size_t count);
+void _vec_priv_pushFrontN(void** vecPtr, const void* values, size_t count);
+void _vec_priv_popBack(void** vecPtr, void* buff);
+void _vec_priv_popFront(void** vecPtr, void* buff);
+void* _vec_priv_slice(void* vec, size_t start, size_t end);
+void _vec_priv_insert(void** vecPtr, size_t index, void* value);
+void _vec_priv_insertRange(void** vecPtr, size_t index, const void* values, size_t count);
+void _vec_priv_remove(void** vecPtr, size_t index, void* buff);
+void _vec_priv_eraseRange(void** vecPtr, size_t start, size_t end);
+void _vec_priv_clear(void** vecPtr);
+size_t _vec_priv_sortedInsert(void** vecPtr, void* value);
+void _vec_priv_sortedInsertN(void** vecPtr, const void* values, size_t count);
+void _vec_priv_sortParallel(vec_view_t view, size_t nthreads, int (*cmp)(const void*, const void*),
+    void (*sortFn)(void*, size_t), void (*mergeFn)(const void*, size_t, const void*, size_t, void*));
+void _vec_priv_deque_pushBack(vec_deque_t* dq, const void* value);
+void _vec_priv_deque_pushFront(vec_deque_t* dq, const void* value);
+void _vec_priv_deque_popBack(vec_deque_t* dq, void* buff);
+void _vec_priv_deque_popFront(vec_deque_t* dq, void* buff);
+void _vec_priv_deque_pushBackN(vec_deque_t* dq, const void* values, size_t count);
+size_t _vec_priv_deque_popFrontN(vec_deque_t* dq, void* buff, size_t count);
+void* _vec_priv_deque_at(const vec_deque_t* dq, size_t index);
+void* _vec_priv_segvec_pushBack(vec_segvec_t* sv, const void* value);
+void _vec_priv_segvec_popBack(vec_segvec_t* sv, void* buff);
+void _vec_priv_segvec_pushBackN(vec_segvec_t* sv, const void* values, size_t count);
+void* _vec_priv_segvec_at(const vec_segvec_t* sv, size_t index);
+void* _vec_priv_segvec_chunk(const vec_segvec_t* sv, size_t chunkIndex, size_t* count);
+void _vec_priv_parallelFor(vec_threadPool_t* pool, size_t n, size_t memSize, const void* base,
+    void (*fn)(void*, size_t, size_t, size_t), void* ctx);
+void* _vec_priv_outputArray(void** outPtr, size_t memSize, size_t size);
+void _vec_priv_truncate(void* vec, size_t size);
+void* _vec_priv_scratch(const void* vec, size_t count);
+void _vec_priv_scratchFree(const void* vec, void* buff);
+size_t _vec_priv_find_int(const int* arr, size_t n, int value);
+size_t _vec_priv_count_int(const int* arr, size_t n, int value);
+int _vec_priv_min_int(const int* arr, size_t n);
+int _vec_priv_max_int(const int* arr, size_t n);
+long long _vec_priv_sum_int(const int* arr, size_t n);
+size_t _vec_priv_find_float(const float* arr, size_t n, float value);
+size_t _vec_priv_count_float(const float* arr, size_t n, float value);
+float _vec_priv_min_float(const float* arr, size_t n);
+float _vec_priv_max_float(const float* arr, size_t n);
+double _vec_priv_sum_float(const float* arr, size_t n);
+size_t _vec_priv_find_double(const double* arr, size_t n, double value);
+size_t _vec_priv_count_double(const double* arr, size_t n, double value);
+double _vec_priv_min_double(const double* arr, size_t n);
+double _vec_priv_max_double(const double* arr, size_t n);
+double _vec_priv_sum_double(const double* arr, size_t n);
+size_t _vec_priv_find_int64(const int64_t* arr, size_t n, int64_t value);
+size_t _vec_priv_count_int64(const int64_t* arr, size_t n, int64_t value);
+int64_t _vec_priv_min_int64(const int64_t* arr, size_t n);
+int64_t _vec_priv_max_int64(const int64_t* arr, size_t n);
+int64_t _vec_priv_sum_int64(const int64_t* arr, size_t n);
+void _vec_debug_print(void* vec, FILE* stream); // write informations about the array to the given stream, for debug purpose
+
+/**
+ * search and reductions for arrays of int, float, double and int64_t
+ * they use AVX2 or SSE2 when the cpu support them (checked once, on the first call), else a simple loop,
+ * the size of the array is read only once.
+ * find return the index of the first element equal to value, or the size of the array if there is none
+ * count return the number of elements equal to value
+ * min and max return 0 for an empty array, the result is unspecified if the array contains NaN
+ * sum of int is done on 64 bits, sum of float is done on doubles, in an unspecified order,
+ * sum of int64_t wrap around on overflow.
+ * other types (unsigned, char, short) have no kernels, the compiler vectorize simple loops on them well enough
+ */
+inline size_t vec_find_int(const int* vec, int value) {
+    return _vec_priv_find_int(vec, vec_size(vec), value);
+}
+inline size_t vec_count_int(const int* vec, int value) {
+    return _vec_priv_count_int(vec, vec_size(vec), value);
+}
+inline int vec_min_int(const int* vec) {
+    return _vec_priv_min_int(vec, vec_size(vec));
+}
+inline int vec_max_int(const int* vec) {
+    return _vec_priv_max_int(vec, vec_size(vec));
+}
+inline long long vec_sum_int(const int* vec) {
+    return _vec_priv_sum_int(vec, vec_size(vec));
+}
+inline size_t vec_find_float(const float* vec, float value) {
+    return _vec_priv_find_float(vec, vec_size(vec), value);
+}
+inline size_t vec_count_float(const float* vec, float value) {
+    return _vec_priv_count_float(vec, vec_size(vec), value);
+}
+inline float vec_min_float(const float* vec) {
+    return _vec_priv_min_float(vec, vec_size(vec));
+}
+inline float vec_max_float(const float* vec) {
+    return _vec_priv_max_float(vec, vec_size(vec));
+}
+inline double vec_sum_float(const float* vec) {
+    return _vec_priv_sum_float(vec, vec_size(vec));
+}
+inline size_t vec_find_double(const double* vec, double value) {
+    return _vec_priv_find_double(vec, vec_size(vec), value);
+}
+inline size_t vec_count_double(const double* vec, double value) {
+    return _vec_priv_count_double(vec, vec_size(vec), value);
+}
+inline double vec_min_double(const double* vec) {
+    return _vec_priv_min_double(vec, vec_size(vec));
+}
+inline double vec_max_double(const double* vec) {
+    return _vec_priv_max_double(vec, vec_size(vec));
+}
+inline double vec_sum_double(const double* vec) {
+    return _vec_priv_sum_double(vec, vec_size(vec));
+}
+inline size_t vec_find_int64(const int64_t* vec, int64_t value) {
+    return _vec_priv_find_int64(vec, vec_size(vec), value);
+}
+inline size_t vec_count_int64(const int64_t* vec, int64_t value) {
+    return _vec_priv_count_int64(vec, vec_size(vec), value);
+}
+inline int64_t vec_min_int64(const int64_t* vec) {
+    return _vec_priv_min_int64(vec, vec_size(vec));
+}
+inline int64_t vec_max_int64(const int64_t* vec) {
+    return _vec_priv_max_int64(vec, vec_size(vec));
+}
+inline int64_t vec_sum_int64(const int64_t* vec) {
+    return _vec_priv_sum_int64(vec, vec_size(vec));
+}
+
+// same functions for views of arrays of int, float, double and int64_t
+inline size_t vec_view_find_int(vec_view_t view, int value) {
+    return _vec_priv_find_int(view.data, view.size, value);
+}
+inline size_t vec_view_count_int(vec_view_t view, int value) {
+    return _vec_priv_count_int(view.data, view.size, value);
+}
+inline int vec_view_min_int(vec_view_t view) {
+    return _vec_priv_min_int(view.data, view.size);
+}
+inline int vec_view_max_int(vec_view_t view) {
+    return _vec_priv_max_int(view.data, view.size);
+}
+inline long long vec_view_sum_int(vec_view_t view) {
+    return _vec_priv_sum_int(view.data, view.size);
+}
+inline size_t vec_view_find_float(vec_view_t view, float value) {
+    return _vec_priv_find_float(view.data, view.size, value);
+}
+inline size_t vec_view_count_float(vec_view_t view, float value) {
+    return _vec_priv_count_float(view.data, view.size, value);
+}
+inline float vec_view_min_float(vec_view_t view) {
+    return _vec_priv_min_float(view.data, view.size);
+}
+inline float vec_view_max_float(vec_view_t view) {
+    return _vec_priv_max_float(view.data, view.size);
+}
+inline double vec_view_sum_float(vec_view_t view) {
+    return _vec_priv_sum_float(view.data, view.size);
+}
+inline size_t vec_view_find_double(vec_view_t view, double value) {
+    return _vec_priv_find_double(view.data, view.size, value);
+}
+inline size_t vec_view_count_double(vec_view_t view, double value) {
+    return _vec_priv_count_double(view.data, view.size, value);
+}
+inline double vec_view_min_double(vec_view_t view) {
+    return _vec_priv_min_double(view.data, view.size);
+}
+inline double vec_view_max_double(vec_view_t view) {
+    return _vec_priv_max_double(view.data, view.size);
+}
+inline double vec_view_sum_double(vec_view_t view) {
+    return _vec_priv_sum_double(view.data, view.size);
+}
+inline size_t vec_view_find_int64(vec_view_t view, int64_t value) {
+    return _vec_priv_find_int64(view.data, view.size, value);
+}
+inline size_t vec_view_count_int64(vec_view_t view, int64_t value) {
+    return _vec_priv_count_int64(view.data, view.size, value);
+}
+inline int64_t vec_view_min_int64(vec_view_t view) {
+    return _vec_priv_min_int64(view.data, view.size);
+}
+inline int64_t vec_view_max_int64(vec_view_t view) {
+    return _vec_priv_max_int64(view.data, view.size);
+}
+inline int64_t vec_view_sum_int64(vec_view_t view) {
+    return _vec_priv_sum_int64(view.data, view.size);
+}
+
+// return the address of the element at the given index of the view, NULL if out of bounds
+inline void* vec_view_at(vec_view_t view, size_t index) {
+    if(index >= view.size) return NULL;
+    return view.data + index * view.memSize;
+}
+
 #endif
\ No newline at end of file
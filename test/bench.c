@@ -0,0 +1,488 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "../src/vector.h"
+
+// default number of elements, can be changed with the first argument
+#define BENCHSIZE (size_t)10000000
+
+VEC_DEF_ALL(int, int)
+VEC_DEF_SORT(int, int, a < b)
+VEC_DEF_SORT_PARALLEL(int, int)
+VEC_DEF_SEARCH(int, int)
+
+typedef void (*bench_func_t)(size_t);
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int int_compare(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int* random_ints(size_t size) {
+    int* v = vec_create_int(size);
+    srand(42);
+    for(size_t i = 0; i < size; i++) {
+        v[i] = rand();
+    }
+    return v;
+}
+
+// sort the same random array with 1 to 16 threads, with the comparator and with the specialized sort
+static void bench_sort_parallel(size_t size) {
+    size_t threads[] = { 1, 2, 4, 8, 16 };
+    size_t count = sizeof(threads) / sizeof(threads[0]);
+    double base = 0, baseTyped = 0;
+    printf("\n\nBENCH vec_sort_parallel(), %zu ints\n\n", size);
+    printf("threads, cmp (s), speedup, typed (s), speedup\n");
+    for(size_t i = 0; i < count; i++) {
+        int* v = random_ints(size);
+        vec_setComparator(v, int_compare);
+        double start = now();
+        vec_sort_parallel(v, threads[i]);
+        double elapsed = now() - start;
+        vec_free(v);
+
+        v = random_ints(size);
+        start = now();
+        vec_sort_parallel_int(v, threads[i]);
+        double elapsedTyped = now() - start;
+        vec_free(v);
+
+        if(i == 0) {
+            base = elapsed;
+            baseTyped = elapsedTyped;
+        }
+        printf("%zu, %.3f, %.2f, %.3f, %.2f\n", threads[i], elapsed, base / elapsed, elapsedTyped, baseTyped / elapsedTyped);
+    }
+}
+
+// search random values in sorted arrays fitting in L1, L3 and only in memory,
+// with bsearch, the branchless lower bound and the Eytzinger layout
+static void bench_search(size_t size) {
+    size_t sizes[] = { (size_t)1 << 12, (size_t)1 << 20, size };
+    size_t count = sizeof(sizes) / sizeof(sizes[0]);
+    size_t queries = (size_t)1 << 22;
+    printf("\n\nBENCH searches, %zu queries\n\n", queries);
+    printf("elements, bsearch (ns/op), lowerBound (ns/op), eytzinger (ns/op)\n");
+    int* keys = vec_create_int(queries);
+    for(size_t i = 0; i < count; i++) {
+        int* v = vec_create_int(sizes[i]);
+        for(size_t j = 0; j < sizes[i]; j++) {
+            v[j] = j * 2;
+        }
+        for(size_t j = 0; j < queries; j++) {
+            keys[j] = rand() % (sizes[i] * 2);
+        }
+        int* eytz = vec_eytzinger_int(v);
+        // accumulate the results so the searches are not optimized out
+        size_t check = 0;
+        double start = now();
+        for(size_t j = 0; j < queries; j++) {
+            check += vec_bsearch_int(v, keys[j], int_compare) != NULL;
+        }
+        double bsearchTime = now() - start;
+        start = now();
+        for(size_t j = 0; j < queries; j++) {
+            check += vec_lowerBound_int(v, keys[j]);
+        }
+        double lowerTime = now() - start;
+        start = now();
+        for(size_t j = 0; j < queries; j++) {
+            check += vec_eytzingerLowerBound_int(eytz, keys[j]);
+        }
+        double eytzTime = now() - start;
+        printf("%zu, %.1f, %.1f, %.1f (%zu)\n", sizes[i], bsearchTime * 1e9 / queries,
+            lowerTime * 1e9 / queries, eytzTime * 1e9 / queries, check % 10);
+        vec_free(eytz);
+        vec_free(v);
+    }
+    vec_free(keys);
+}
+
+// compare the reduction kernels with a hand-written loop that calls vec_size() in its condition
+static void bench_reduce(size_t size) {
+    int* v = random_ints(size);
+    size_t repeat = 10;
+    long long check = 0;
+    printf("\n\nBENCH reductions, %zu ints\n\n", size);
+    printf("function, loop (ns/elem), kernel (ns/elem)\n");
+
+    double start = now();
+    for(size_t r = 0; r < repeat; r++) {
+        long long sum = 0;
+        for(size_t i = 0; i < vec_size(v); i++) sum += v[i];
+        check += sum;
+    }
+    double loopTime = now() - start;
+    start = now();
+    for(size_t r = 0; r < repeat; r++) check += vec_sum_int(v);
+    double kernelTime = now() - start;
+    printf("sum, %.3f, %.3f\n", loopTime * 1e9 / (size * repeat), kernelTime * 1e9 / (size * repeat));
+
+    start = now();
+    for(size_t r = 0; r < repeat; r++) {
+        size_t count = 0;
+        for(size_t i = 0; i < vec_size(v); i++) count += v[i] == 42;
+        check += count;
+    }
+    loopTime = now() - start;
+    start = now();
+    for(size_t r = 0; r < repeat; r++) check += vec_count_int(v, 42);
+    kernelTime = now() - start;
+    printf("count, %.3f, %.3f\n", loopTime * 1e9 / (size * repeat), kernelTime * 1e9 / (size * repeat));
+
+    start = now();
+    for(size_t r = 0; r < repeat; r++) {
+        int min = v[0];
+        for(size_t i = 1; i < vec_size(v); i++) if(v[i] < min) min = v[i];
+        check += min;
+    }
+    loopTime = now() - start;
+    start = now();
+    for(size_t r = 0; r < repeat; r++) check += vec_min_int(v);
+    kernelTime = now() - start;
+    printf("min, %.3f, %.3f\n", loopTime * 1e9 / (size * repeat), kernelTime * 1e9 / (size * repeat));
+
+    // -1 is never generated by rand, so the whole array is scanned
+    start = now();
+    for(size_t r = 0; r < repeat; r++) {
+        size_t i = 0;
+        while(i < vec_size(v) && v[i] != -1) i++;
+        check += i;
+    }
+    loopTime = now() - start;
+    start = now();
+    for(size_t r = 0; r < repeat; r++) check += vec_find_int(v, -1);
+    kernelTime = now() - start;
+    printf("find, %.3f, %.3f\n", loopTime * 1e9 / (size * repeat), kernelTime * 1e9 / (size * repeat));
+    printf("(%lld)\n", check % 10);
+    vec_free(v);
+}
+
+static void* copy_alloc(void* ctx, size_t size) {
+    return malloc(size);
+}
+
+static void copy_free(void* ctx, void* ptr, size_t size) {
+    free(ptr);
+}
+
+// grow an array by pushing, with the default allocator (realloc, mremap for big arrays)
+// and with an allocator without realloc (every resize copy the elements)
+static void bench_grow(size_t size) {
+    vec_allocator_t copying = { copy_alloc, NULL, copy_free, NULL };
+    const vec_allocator_t* allocators[] = { NULL, &copying };
+    const char* names[] = { "realloc", "copy" };
+    printf("\n\nBENCH growth by vec_pushBack(), %zu ints\n\n", size);
+    printf("allocator, total (s), ns/push\n");
+    for(size_t i = 0; i < 2; i++) {
+        int* v = vec_create_with_allocator_int(0, allocators[i]);
+        double start = now();
+        for(size_t j = 0; j < size; j++) {
+            vec_pushBack_int(&v, j);
+        }
+        double elapsed = now() - start;
+        printf("%s, %.3f, %.2f\n", names[i], elapsed, elapsed * 1e9 / size);
+        vec_free(v);
+    }
+}
+
+// operations suite: each operation is timed for every element size and count,
+// in a child process so the peak RSS is the one of the operation, and the heap is fresh.
+// the results are written in CSV or JSON, with the same columns as bench_std.cpp (the C++ baseline)
+
+// counts from 10^2 to the max count, by powers of 10
+#define BENCH_MIN_COUNT (size_t)100
+// rows needing more memory than that are skipped
+#define BENCH_MAX_BYTES ((size_t)1 << 30)
+// the O(n) per op operations are limited to this count
+#define BENCH_QUADRATIC_MAX (size_t)100000
+// small counts are repeated to do about this number of ops, and the best run is kept
+#define BENCH_REPEAT_OPS (size_t)100000
+#define BENCH_SEED 88172645463325252ull
+
+// elements of 4 to 256 bytes, with an int key to sort them
+typedef struct { int key; } elem4_t;
+typedef struct { int key; char pad[12]; } elem16_t;
+typedef struct { int key; char pad[60]; } elem64_t;
+typedef struct { int key; char pad[252]; } elem256_t;
+
+VEC_DEF_ALL(elem4_t, elem4)
+VEC_DEF_ALL(elem16_t, elem16)
+VEC_DEF_ALL(elem64_t, elem64)
+VEC_DEF_ALL(elem256_t, elem256)
+
+// xorshift, so the sequences are the same on every platform and in the C++ baseline
+static uint64_t bench_rng;
+
+static uint32_t bench_random(void) {
+    bench_rng ^= bench_rng << 13;
+    bench_rng ^= bench_rng >> 7;
+    bench_rng ^= bench_rng << 17;
+    return bench_rng >> 32;
+}
+
+// an operation run n times, return the elapsed time and set the number of ops done
+typedef double (*bench_op_func_t)(size_t n, size_t* ops);
+
+typedef struct {
+    const char* name;
+    bench_op_func_t func;
+    size_t maxCount;
+} bench_op_t;
+
+// define the operations for an element type
+#define BENCH_DEF_OPS(type, suffix) \
+    static int bench_compare_##suffix(const void* a, const void* b) { \
+        int x = ((const type*)a)->key, y = ((const type*)b)->key; \
+        return (x > y) - (x < y); \
+    } \
+    static type* bench_fill_##suffix(size_t n) { \
+        type* v = vec_create_##suffix(n); \
+        memset(v, 0, n * sizeof(type)); \
+        for(size_t i = 0; i < n; i++) v[i].key = bench_random(); \
+        return v; \
+    } \
+    static double bench_pushBack_##suffix(size_t n, size_t* ops) { \
+        type e = { 0 }; \
+        type* v = vec_create_##suffix(0); \
+        double start = now(); \
+        for(size_t i = 0; i < n; i++) { \
+            e.key = i; \
+            vec_pushBack_##suffix(&v, e); \
+        } \
+        double elapsed = now() - start; \
+        vec_free(v); \
+        *ops = n; \
+        return elapsed; \
+    } \
+    static double bench_pushFront_##suffix(size_t n, size_t* ops) { \
+        type e = { 0 }; \
+        type* v = vec_create_##suffix(0); \
+        double start = now(); \
+        for(size_t i = 0; i < n; i++) { \
+            e.key = i; \
+            vec_pushFront_##suffix(&v, e); \
+        } \
+        double elapsed = now() - start; \
+        vec_free(v); \
+        *ops = n; \
+        return elapsed; \
+    } \
+    static double bench_popFront_##suffix(size_t n, size_t* ops) { \
+        type* v = bench_fill_##suffix(n); \
+        double start = now(); \
+        for(size_t i = 0; i < n; i++) { \
+            vec_popFront_##suffix(&v); \
+        } \
+        double elapsed = now() - start; \
+        vec_free(v); \
+        *ops = n; \
+        return elapsed; \
+    } \
+    static double bench_insert_##suffix(size_t n, size_t* ops) { \
+        type e = { 0 }; \
+        type* v = vec_create_##suffix(0); \
+        double start = now(); \
+        for(size_t i = 0; i < n; i++) { \
+            e.key = i; \
+            vec_insert_##suffix(&v, bench_random() % (i + 1), e); \
+        } \
+        double elapsed = now() - start; \
+        vec_free(v); \
+        *ops = n; \
+        return elapsed; \
+    } \
+    static double bench_sortedInsert_##suffix(size_t n, size_t* ops) { \
+        type e = { 0 }; \
+        type* v = vec_create_##suffix(0); \
+        vec_setComparator(v, bench_compare_##suffix); \
+        double start = now(); \
+        for(size_t i = 0; i < n; i++) { \
+            e.key = bench_random(); \
+            vec_sortedInsert_##suffix(&v, e); \
+        } \
+        double elapsed = now() - start; \
+        vec_free(v); \
+        *ops = n; \
+        return elapsed; \
+    } \
+    static double bench_sort_##suffix(size_t n, size_t* ops) { \
+        type* v = bench_fill_##suffix(n); \
+        double start = now(); \
+        vec_qsort(v, bench_compare_##suffix); \
+        double elapsed = now() - start; \
+        vec_free(v); \
+        *ops = n; \
+        return elapsed; \
+    } \
+    static double bench_swap_##suffix(size_t n, size_t* ops) { \
+        type* v = bench_fill_##suffix(n); \
+        double start = now(); \
+        for(size_t i = 0; i < n; i++) { \
+            vec_swap(v, bench_random() % n, bench_random() % n); \
+        } \
+        double elapsed = now() - start; \
+        vec_free(v); \
+        *ops = n; \
+        return elapsed; \
+    } \
+    static double bench_reverse_##suffix(size_t n, size_t* ops) { \
+        type* v = bench_fill_##suffix(n); \
+        double start = now(); \
+        vec_reverse(v); \
+        double elapsed = now() - start; \
+        vec_free(v); \
+        *ops = n; \
+        return elapsed; \
+    } \
+    /* slices of 64 elements at random positions, one op per slice */ \
+    static double bench_slice_##suffix(size_t n, size_t* ops) { \
+        type* v = bench_fill_##suffix(n); \
+        size_t len = n < 64 ? n : 64; \
+        double start = now(); \
+        for(size_t i = 0; i < n; i++) { \
+            size_t from = bench_random() % (n - len + 1); \
+            vec_free(vec_slice_##suffix(v, from, from + len)); \
+        } \
+        double elapsed = now() - start; \
+        vec_free(v); \
+        *ops = n; \
+        return elapsed; \
+    } \
+    /* create an array, push 16 elements and free it, one op per array */ \
+    static double bench_churn_##suffix(size_t n, size_t* ops) { \
+        type e = { 0 }; \
+        double start = now(); \
+        for(size_t i = 0; i < n; i++) { \
+            type* v = vec_create_##suffix(0); \
+            for(int j = 0; j < 16; j++) vec_pushBack_##suffix(&v, e); \
+            vec_free(v); \
+        } \
+        double elapsed = now() - start; \
+        *ops = n; \
+        return elapsed; \
+    } \
+    static const bench_op_t bench_ops_##suffix[] = { \
+        { "pushBack", bench_pushBack_##suffix, 0 }, \
+        { "pushFront", bench_pushFront_##suffix, 0 }, \
+        { "popFront", bench_popFront_##suffix, 0 }, \
+        { "insert", bench_insert_##suffix, BENCH_QUADRATIC_MAX }, \
+        { "sortedInsert", bench_sortedInsert_##suffix, BENCH_QUADRATIC_MAX }, \
+        { "sort", bench_sort_##suffix, 0 }, \
+        { "swap", bench_swap_##suffix, 0 }, \
+        { "reverse", bench_reverse_##suffix, 0 }, \
+        { "slice", bench_slice_##suffix, 0 }, \
+        { "churn", bench_churn_##suffix, 0 } \
+    };
+
+BENCH_DEF_OPS(elem4_t, elem4)
+BENCH_DEF_OPS(elem16_t, elem16)
+BENCH_DEF_OPS(elem64_t, elem64)
+BENCH_DEF_OPS(elem256_t, elem256)
+
+typedef enum { BENCH_TEXT, BENCH_CSV, BENCH_JSON } bench_format_t;
+
+static void bench_print_row(bench_format_t format, const char* op, size_t elemSize, size_t count,
+    size_t ops, double elapsed, long peakRss) {
+    double nsPerOp = elapsed * 1e9 / ops;
+    double opsPerSec = ops / elapsed;
+    if(format == BENCH_JSON) {
+        printf("{\"impl\": \"vector_lib\", \"op\": \"%s\", \"elem_size\": %zu, \"count\": %zu, \"ops\": %zu, "
+            "\"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"peak_rss_kb\": %ld}\n",
+            op, elemSize, count, ops, nsPerOp, opsPerSec, peakRss);
+    } else {
+        printf("vector_lib,%s,%zu,%zu,%zu,%.3f,%.0f,%ld\n", op, elemSize, count, ops, nsPerOp, opsPerSec, peakRss);
+    }
+}
+
+// run one operation in a child process and print its row
+static void bench_run_op(bench_format_t format, const bench_op_t* op, size_t elemSize, size_t count) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if(pid < 0) {
+        perror("fork");
+        return;
+    }
+    if(pid == 0) {
+        size_t ops = 0;
+        double elapsed = 0;
+        for(size_t rep = 0; rep == 0 || rep * count < BENCH_REPEAT_OPS; rep++) {
+            bench_rng = BENCH_SEED;
+            double runElapsed = op->func(count, &ops);
+            if(rep == 0 || runElapsed < elapsed) elapsed = runElapsed;
+        }
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        bench_print_row(format, op->name, elemSize, count, ops, elapsed, usage.ru_maxrss);
+        fflush(stdout);
+        _exit(0);
+    }
+    waitpid(pid, NULL, 0);
+}
+
+// run all operations for all element sizes and counts up to maxCount
+static void bench_ops(size_t maxCount, bench_format_t format) {
+    const bench_op_t* ops[] = { bench_ops_elem4, bench_ops_elem16, bench_ops_elem64, bench_ops_elem256 };
+    size_t elemSizes[] = { sizeof(elem4_t), sizeof(elem16_t), sizeof(elem64_t), sizeof(elem256_t) };
+    size_t opCount = sizeof(bench_ops_elem4) / sizeof(bench_op_t);
+    if(format == BENCH_TEXT) printf("\n\nBENCH operations, up to %zu elements (CSV)\n\n", maxCount);
+    if(format != BENCH_JSON) printf("impl,op,elem_size,count,ops,ns_per_op,ops_per_sec,peak_rss_kb\n");
+    for(size_t i = 0; i < opCount; i++) {
+        for(size_t j = 0; j < sizeof(elemSizes) / sizeof(elemSizes[0]); j++) {
+            for(size_t count = BENCH_MIN_COUNT; count <= maxCount; count *= 10) {
+                if(ops[j][i].maxCount && count > ops[j][i].maxCount) break;
+                if(count * elemSizes[j] > BENCH_MAX_BYTES) break;
+                bench_run_op(format, &ops[j][i], elemSizes[j], count);
+            }
+        }
+    }
+}
+
+static void bench_ops_text(size_t size) {
+    bench_ops(size, BENCH_TEXT);
+}
+
+// usage: bench.out [size] [csv|json]
+// with csv or json, only the operations suite is run, and its results are the only output
+int main(int argc, char const *argv[])
+{
+    size_t size = BENCHSIZE;
+    bench_format_t format = BENCH_TEXT;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "csv") == 0) format = BENCH_CSV;
+        else if(strcmp(argv[i], "json") == 0) format = BENCH_JSON;
+        else size = strtoull(argv[i], NULL, 10);
+    }
+    if(format != BENCH_TEXT) {
+        bench_ops(size, format);
+        return 0;
+    }
+    bench_func_t benchs[] = {
+        bench_sort_parallel,
+        bench_search,
+        bench_reduce,
+        bench_grow,
+        bench_ops_text
+    };
+    size_t benchSize = sizeof(benchs) / sizeof(benchs[0]);
+    printf("\n\nSTARTING BENCH FOR VECTOR LIB\n");
+    for(size_t i = 0; i < benchSize; i++) {
+        benchs[i](size);
+    }
+    printf("\n\nBENCH FOR VECTOR LIB DONE\n\n");
+    return 0;
+}
@@ -0,0 +1,249 @@
+// C++ baseline for the operations suite of bench.c, with std::vector (and std::deque for the front operations)
+// same operations, element sizes, counts, random sequences and output columns,
+// so the rows can be compared with the ones of bench.out
+// usage: bench_std.out [maxCount] [csv|json]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#define BENCHSIZE (size_t)10000000
+#define BENCH_MIN_COUNT (size_t)100
+#define BENCH_MAX_BYTES ((size_t)1 << 30)
+#define BENCH_QUADRATIC_MAX (size_t)100000
+#define BENCH_REPEAT_OPS (size_t)100000
+#define BENCH_SEED 88172645463325252ull
+
+struct elem4_t { int key; };
+struct elem16_t { int key; char pad[12]; };
+struct elem64_t { int key; char pad[60]; };
+struct elem256_t { int key; char pad[252]; };
+
+template<typename T>
+static bool operator<(const T& a, const T& b) {
+    return a.key < b.key;
+}
+
+static uint64_t bench_rng;
+
+static uint32_t bench_random() {
+    bench_rng ^= bench_rng << 13;
+    bench_rng ^= bench_rng >> 7;
+    bench_rng ^= bench_rng << 17;
+    return bench_rng >> 32;
+}
+
+static double now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template<typename T>
+static std::vector<T> bench_fill(size_t n) {
+    std::vector<T> v(n, T());
+    for(size_t i = 0; i < n; i++) v[i].key = bench_random();
+    return v;
+}
+
+template<typename T>
+static double bench_pushBack(size_t n) {
+    T e = T();
+    std::vector<T> v;
+    double start = now();
+    for(size_t i = 0; i < n; i++) {
+        e.key = i;
+        v.push_back(e);
+    }
+    return now() - start;
+}
+
+template<typename T>
+static double bench_pushFront(size_t n) {
+    T e = T();
+    std::deque<T> v;
+    double start = now();
+    for(size_t i = 0; i < n; i++) {
+        e.key = i;
+        v.push_front(e);
+    }
+    return now() - start;
+}
+
+template<typename T>
+static double bench_popFront(size_t n) {
+    std::vector<T> filled = bench_fill<T>(n);
+    std::deque<T> v(filled.begin(), filled.end());
+    double start = now();
+    for(size_t i = 0; i < n; i++) {
+        v.pop_front();
+    }
+    return now() - start;
+}
+
+template<typename T>
+static double bench_insert(size_t n) {
+    T e = T();
+    std::vector<T> v;
+    double start = now();
+    for(size_t i = 0; i < n; i++) {
+        e.key = i;
+        v.insert(v.begin() + bench_random() % (i + 1), e);
+    }
+    return now() - start;
+}
+
+template<typename T>
+static double bench_sortedInsert(size_t n) {
+    T e = T();
+    std::vector<T> v;
+    double start = now();
+    for(size_t i = 0; i < n; i++) {
+        e.key = bench_random();
+        v.insert(std::upper_bound(v.begin(), v.end(), e), e);
+    }
+    return now() - start;
+}
+
+template<typename T>
+static double bench_sort(size_t n) {
+    std::vector<T> v = bench_fill<T>(n);
+    double start = now();
+    std::sort(v.begin(), v.end());
+    return now() - start;
+}
+
+template<typename T>
+static double bench_swap(size_t n) {
+    std::vector<T> v = bench_fill<T>(n);
+    double start = now();
+    for(size_t i = 0; i < n; i++) {
+        size_t a = bench_random() % n;
+        size_t b = bench_random() % n;
+        std::swap(v[a], v[b]);
+    }
+    return now() - start;
+}
+
+template<typename T>
+static double bench_reverse(size_t n) {
+    std::vector<T> v = bench_fill<T>(n);
+    double start = now();
+    std::reverse(v.begin(), v.end());
+    return now() - start;
+}
+
+template<typename T>
+static double bench_slice(size_t n) {
+    std::vector<T> v = bench_fill<T>(n);
+    size_t len = n < 64 ? n : 64;
+    size_t check = 0;
+    double start = now();
+    for(size_t i = 0; i < n; i++) {
+        size_t from = bench_random() % (n - len + 1);
+        std::vector<T> slice(v.begin() + from, v.begin() + from + len);
+        check += slice.size();
+    }
+    double elapsed = now() - start;
+    if(check == 0) std::printf(" ");
+    return elapsed;
+}
+
+template<typename T>
+static double bench_churn(size_t n) {
+    T e = T();
+    double start = now();
+    for(size_t i = 0; i < n; i++) {
+        std::vector<T> v;
+        for(int j = 0; j < 16; j++) v.push_back(e);
+    }
+    return now() - start;
+}
+
+struct bench_op_t {
+    const char* name;
+    const char* impl;
+    double (*func)(size_t);
+    size_t maxCount;
+};
+
+template<typename T>
+static const bench_op_t* bench_ops() {
+    static const bench_op_t ops[] = {
+        { "pushBack", "std::vector", bench_pushBack<T>, 0 },
+        { "pushFront", "std::deque", bench_pushFront<T>, 0 },
+        { "popFront", "std::deque", bench_popFront<T>, 0 },
+        { "insert", "std::vector", bench_insert<T>, BENCH_QUADRATIC_MAX },
+        { "sortedInsert", "std::vector", bench_sortedInsert<T>, BENCH_QUADRATIC_MAX },
+        { "sort", "std::vector", bench_sort<T>, 0 },
+        { "swap", "std::vector", bench_swap<T>, 0 },
+        { "reverse", "std::vector", bench_reverse<T>, 0 },
+        { "slice", "std::vector", bench_slice<T>, 0 },
+        { "churn", "std::vector", bench_churn<T>, 0 }
+    };
+    return ops;
+}
+
+#define BENCH_OP_COUNT 10
+
+static void bench_run_op(bool json, const bench_op_t* op, size_t elemSize, size_t count) {
+    std::fflush(stdout);
+    pid_t pid = fork();
+    if(pid < 0) {
+        std::perror("fork");
+        return;
+    }
+    if(pid == 0) {
+        double elapsed = 0;
+        for(size_t rep = 0; rep == 0 || rep * count < BENCH_REPEAT_OPS; rep++) {
+            bench_rng = BENCH_SEED;
+            double runElapsed = op->func(count);
+            if(rep == 0 || runElapsed < elapsed) elapsed = runElapsed;
+        }
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        double nsPerOp = elapsed * 1e9 / count;
+        double opsPerSec = count / elapsed;
+        if(json) {
+            std::printf("{\"impl\": \"%s\", \"op\": \"%s\", \"elem_size\": %zu, \"count\": %zu, \"ops\": %zu, "
+                "\"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"peak_rss_kb\": %ld}\n",
+                op->impl, op->name, elemSize, count, count, nsPerOp, opsPerSec, usage.ru_maxrss);
+        } else {
+            std::printf("%s,%s,%zu,%zu,%zu,%.3f,%.0f,%ld\n", op->impl, op->name, elemSize, count, count,
+                nsPerOp, opsPerSec, usage.ru_maxrss);
+        }
+        std::fflush(stdout);
+        _exit(0);
+    }
+    waitpid(pid, NULL, 0);
+}
+
+int main(int argc, char const *argv[])
+{
+    size_t maxCount = BENCHSIZE;
+    bool json = false;
+    for(int i = 1; i < argc; i++) {
+        if(std::strcmp(argv[i], "json") == 0) json = true;
+        else if(std::strcmp(argv[i], "csv") != 0) maxCount = std::strtoull(argv[i], NULL, 10);
+    }
+    const bench_op_t* ops[] = { bench_ops<elem4_t>(), bench_ops<elem16_t>(), bench_ops<elem64_t>(), bench_ops<elem256_t>() };
+    size_t elemSizes[] = { sizeof(elem4_t), sizeof(elem16_t), sizeof(elem64_t), sizeof(elem256_t) };
+    if(!json) std::printf("impl,op,elem_size,count,ops,ns_per_op,ops_per_sec,peak_rss_kb\n");
+    for(size_t i = 0; i < BENCH_OP_COUNT; i++) {
+        for(size_t j = 0; j < sizeof(elemSizes) / sizeof(elemSizes[0]); j++) {
+            for(size_t count = BENCH_MIN_COUNT; count <= maxCount; count *= 10) {
+                if(ops[j][i].maxCount && count > ops[j][i].maxCount) break;
+                if(count * elemSizes[j] > BENCH_MAX_BYTES) break;
+                bench_run_op(json, &ops[j][i], elemSizes[j], count);
+            }
+        }
+    }
+    return 0;
+}
@@ -13,6 +13,47 @@ typedef struct {
 
 VEC_DEF_ALL(int, int)
 VEC_DEF_ALL(test_struct_t, test_struct)
+VEC_DEF_SORT(int, int, a < b)
+VEC_DEF_SORT(test_struct_t, test_struct, a.a < b.a)
+VEC_DEF_SORT_PARALLEL(int, int)
+VEC_DEF_SEARCH(int, int)
+VEC_DEF_SET(int, int)
+VEC_DEF_HEAP(int, int, a < b)
+VEC_DEF_HEAP_ARITY(test_struct_t, test_struct, a.a > b.a, 2)
+VEC_DEF_DEQUE(int, int)
+VEC_DEF_SEGVEC(int, int)
+VEC_DEF_HASHMAP(int, int, int, (unsigned), a == b)
+VEC_DEF_HASHMAP(const char*, int, str, vec_hash_string, strcmp(a, b) == 0)
+VEC_DEF_PARALLEL_MAP(int, float, half, a / 2.0f + i * *(float*)ctx)
+VEC_DEF_PARALLEL_MAP(int, int, twice, a * 2)
+VEC_DEF_PARALLEL_FILTER(int, multiple, a % *(int*)ctx == 0)
+VEC_DEF_PARALLEL_REDUCE(int, long long, sum, acc + a, acc + b)
+VEC_DEF_PARALLEL_REDUCE(int, int, max, a > acc ? a : acc, b > acc ? b : acc)
+typedef struct {
+    vec_threadPool_t* pool;
+    int* inner;
+} test_nested_t;
+// the first element of each part is replaced by the sum of an inner loop on the same pool
+VEC_DEF_PARALLEL_MAP(int, int, nested, i % 4096 == 0
+    ? (int)vec_parallelReduce_sum(((test_nested_t*)ctx)->pool, ((test_nested_t*)ctx)->inner, 0, NULL) : a)
+VEC_DEF_STAGE_MAP(int, float, half, a / 2.0f)
+VEC_DEF_STAGE_FILTER(int, multiple, a % *(int*)ctx == 0)
+VEC_DEF_STAGE_FILTER(float, big, a >= 10.0f)
+VEC_DEF_STAGE_CHAIN(int, int, float, multipleHalf, multiple, half)
+VEC_DEF_STAGE_CHAIN(int, float, float, bigMultipleHalf, multipleHalf, big)
+VEC_DEF_PIPELINE(int, float, bigMultipleHalf, bigMultipleHalf)
+VEC_DEF_PIPELINE(int, int, multiple, multiple)
+VEC_DEF_PIPELINE_REDUCE(int, int, multiple, multipleSum, acc + a)
+VEC_DEF_PIPELINE_REDUCE(int, long long, multiple, multipleScaled, acc + (long long)a * *(int*)ctx)
+VEC_DEF_REMOVE_IF(int, multiple, a % *(int*)ctx == 0)
+VEC_DEF_ALL(float, float)
+VEC_DEF_ALL(double, double)
+VEC_DEF_ALL(int64_t, int64)
+VEC_DEF_RADIXSORT(int, int, a)
+VEC_DEF_RADIXSORT(float, float, a)
+VEC_DEF_RADIXSORT(test_struct_t, test_struct_a, a.a)
+VEC_DEF_RADIXSORT(test_struct_t, test_struct_c, a.c)
+VEC_DEF_RADIXSORT(test_struct_t, test_struct_uc, (unsigned char)a.c)
 
 #define PUSH_CASE 2
 
@@ -24,7 +65,29 @@ void test_all(void)
         test_vec_push_front,
         test_vec_pop_back,
         test_vec_pop_front,
-        test_vec_customStruct
+        test_vec_customStruct,
+        test_vec_policy,
+        test_vec_bulk,
+        test_vec_insert_remove,
+        test_vec_typed_sort,
+        test_vec_radix_sort,
+        test_vec_parallel_sort,
+        test_vec_sorted_insert_n,
+        test_vec_search,
+        test_vec_reduce,
+        test_vec_deque,
+        test_vec_erase,
+        test_vec_view,
+        test_vec_allocator,
+        test_vec_aligned,
+        test_vec_stats,
+        test_vec_segvec,
+        test_vec_cache,
+        test_vec_parallel,
+        test_vec_pipe,
+        test_vec_set,
+        test_vec_hashmap,
+        test_vec_heap
     };
     size_t test_size = sizeof(test_funcs) / sizeof(test_funcs[0]);
     size_t passed = 0;
@@ -263,3 +326,1961 @@ size_t test_vec_customStruct(size_t testSize, size_t *testCase)
 }
 
 
+
+
+// check that pushing and popping around a power of 2 doesn't reallocate the array
+static int test_vec_policy_1(size_t testSize) {
+    int* v = vec_create_int(0);
+    for(int i = 0; i < 64; i++) {
+        vec_pushBack_int(&v, i);
+    }
+    // this push grow the array, following pops and pushes should not reallocate
+    vec_pushBack_int(&v, 64);
+    int* addr = v;
+    int res = 1;
+    for(int i = 0; i < testSize; i++) {
+        vec_popBack_int(&v);
+        vec_popBack_int(&v);
+        vec_pushBack_int(&v, i);
+        vec_pushBack_int(&v, i);
+        if(v != addr) {
+            res = 0;
+            break;
+        }
+    }
+    vec_free(v);
+    return res;
+}
+
+// check that an array that never shrink keep its memory when emptied
+static int test_vec_policy_2(size_t testSize) {
+    int* v = vec_create_int(0);
+    vec_setPolicy(v, VEC_DEFAULT_GROWTH, VEC_SHRINK_NEVER);
+    for(int i = 0; i < testSize; i++) {
+        vec_pushBack_int(&v, i);
+    }
+    int* addr = v;
+    for(int i = 0; i < testSize; i++) {
+        vec_popBack_int(&v);
+    }
+    vec_clear_int(&v);
+    for(int i = 0; i < testSize; i++) {
+        vec_pushBack_int(&v, i);
+    }
+    int res = v == addr && vec_size(v) == testSize;
+    vec_free(v);
+    return res;
+}
+
+// check that a queue (pushBack + popFront) keep its elements in order with a custom growth factor
+static int test_vec_policy_3(size_t testSize) {
+    int* v = vec_create_int(0);
+    vec_setPolicy(v, 400, 8);
+    int res = 1, next = 0;
+    for(int i = 0; i < testSize * 10; i++) {
+        vec_pushBack_int(&v, i);
+        vec_pushBack_int(&v, i);
+        if(vec_popFront_int(&v) != next / 2) {
+            res = 0;
+            break;
+        }
+        next++;
+    }
+    res = res && vec_size(v) == testSize * 10;
+    vec_free(v);
+    return res;
+}
+
+// check that a growth factor of 1.5 is followed, and the capacity always hold the elements
+static int test_vec_policy_4(size_t testSize) {
+    int* v = vec_create_int(0);
+    vec_setPolicy(v, 150, VEC_DEFAULT_SHRINK);
+    size_t capacity = vec_capacity(v);
+    int res = 1;
+    for(int i = 0; res && i < testSize * 100; i++) {
+        vec_pushBack_int(&v, i);
+        size_t newCapacity = vec_capacity(v);
+        if(newCapacity != capacity) {
+            // grown by 1.5 (+1 as 1.5 * small capacities is rounded down)
+            res = newCapacity <= capacity + capacity / 2 + 1 && newCapacity > capacity;
+            capacity = newCapacity;
+        }
+        res = res && vec_size(v) <= capacity && v[i] == i;
+    }
+    vec_free(v);
+    return res;
+}
+
+// check that the capacity is exactly the reserved size, and shrinkToFit
+static int test_vec_policy_5(size_t testSize) {
+    size_t size = testSize * 6 + 1;
+    int* v = vec_create_int(0);
+    vec_allocate(&v, size, 0);
+    int res = vec_capacity(v) == size && vec_size(v) == 0;
+    for(int i = 0; i < size; i++) {
+        vec_pushBack_int(&v, i);
+    }
+    res = res && vec_capacity(v) == size;
+    // the room left at the front by popFront is reused by the reserve, without growing
+    vec_popFront_int(&v);
+    vec_allocate(&v, size, 0);
+    vec_pushBack_int(&v, 0);
+    res = res && vec_capacity(v) == size && v[0] == 1 && v[size - 1] == 0;
+    vec_popBack_int(&v);
+    vec_popBack_int(&v);
+    vec_shrinkToFit(&v);
+    res = res && vec_capacity(v) == size - 2 && vec_size(v) == size - 2;
+    for(int i = 0; res && i < size - 2; i++) {
+        if(v[i] != i + 1) res = 0;
+    }
+    vec_free(v);
+    return res;
+}
+
+size_t test_vec_policy(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_policy_1,
+        test_vec_policy_2,
+        test_vec_policy_3,
+        test_vec_policy_4,
+        test_vec_policy_5
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING vec_setPolicy(), vec_allocate() and vec_shrinkToFit()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check that pushBackN append the values in order, in multiple batches
+static int test_vec_bulk_1(size_t testSize) {
+    int* v = vec_create_int(0);
+    int* values = malloc(testSize * sizeof(int));
+    for(int i = 0; i < testSize; i++) {
+        values[i] = i;
+    }
+    vec_pushBackN_int(&v, values, testSize / 2);
+    vec_pushBackN_int(&v, values + testSize / 2, testSize - testSize / 2);
+    int res = vec_size(v) == testSize;
+    for(int i = 0; res && i < testSize; i++) {
+        if(v[i] != i) res = 0;
+    }
+    free(values);
+    vec_free(v);
+    return res;
+}
+
+// check that pushFrontN prepend the values keeping their order
+static int test_vec_bulk_2(size_t testSize) {
+    int* v = vec_create_int(0);
+    int* values = malloc(testSize * sizeof(int));
+    for(int i = 0; i < testSize; i++) {
+        values[i] = i;
+    }
+    vec_pushBackN_int(&v, values + testSize / 2, testSize - testSize / 2);
+    vec_pushFrontN_int(&v, values, testSize / 2);
+    int res = vec_size(v) == testSize;
+    for(int i = 0; res && i < testSize; i++) {
+        if(v[i] != i) res = 0;
+    }
+    free(values);
+    vec_free(v);
+    return res;
+}
+
+// check that insertRange insert the values at the right place, near the front and the back
+static int test_vec_bulk_3(size_t testSize) {
+    int* v = vec_create_int(0);
+    int* values = malloc(testSize * sizeof(int));
+    for(int i = 0; i < testSize; i++) {
+        values[i] = i;
+    }
+    // leave some room at the front so the insertion can move the left part
+    vec_pushFrontN_int(&v, values, 1);
+    vec_pushBackN_int(&v, values + testSize - 1, 1);
+    vec_insertRange_int(&v, 1, values + 1, testSize - 2);
+    int res = vec_size(v) == testSize;
+    for(int i = 0; res && i < testSize; i++) {
+        if(v[i] != i) res = 0;
+    }
+    vec_insertRange_int(&v, 2, values, 3);
+    vec_insertRange_int(&v, vec_size(v) - 1, values, 3);
+    res = res && vec_size(v) == testSize + 6 && v[2] == 0 && v[4] == 2 && v[5] == 2
+        && v[testSize + 2] == 0 && v[testSize + 5] == testSize - 1 && v[testSize + 1] == testSize - 2;
+    free(values);
+    vec_free(v);
+    return res;
+}
+
+// check the bulk functions with values taken from the array itself, on a full array
+static int test_vec_bulk_4(size_t testSize) {
+    int* v = vec_create_int(testSize);
+    for(int i = 0; i < testSize; i++) {
+        v[i] = i;
+    }
+    vec_shrinkToFit(&v);
+    vec_pushBackN_int(&v, v, testSize);
+    int res = vec_size(v) == testSize * 2;
+    for(int i = 0; res && i < testSize * 2; i++) {
+        if(v[i] != i % testSize) res = 0;
+    }
+    vec_shrinkToFit(&v);
+    vec_pushFrontN_int(&v, v + testSize, 2);
+    res = res && vec_size(v) == testSize * 2 + 2 && v[0] == 0 && v[1] == 1 && v[2] == 0;
+    vec_shrinkToFit(&v);
+    vec_insertRange_int(&v, testSize, v + 2, testSize);
+    res = res && vec_size(v) == testSize * 3 + 2;
+    for(int i = 0; res && i < testSize; i++) {
+        if(v[testSize + i] != i) res = 0;
+    }
+    vec_free(v);
+    return res;
+}
+
+size_t test_vec_bulk(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_bulk_1,
+        test_vec_bulk_2,
+        test_vec_bulk_3,
+        test_vec_bulk_4
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING vec_pushBackN(), vec_pushFrontN() and vec_insertRange()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+static int int_compare(const void* a, const void* b) {
+    return *(const int*)a - *(const int*)b;
+}
+
+// check that inserting and removing in the middle, which resize the array many times, keep the elements and the infos
+static int test_vec_insert_remove_1(size_t testSize) {
+    int* v = vec_create_int(0);
+    vec_setComparator(v, int_compare);
+    for(int i = 0; i < testSize; i++) {
+        vec_sortedInsert_int(&v, (i * 7) % testSize);
+    }
+    int res = vec_size(v) == testSize && vec_isSorted(v);
+    for(int i = 0; res && i < testSize / 2; i++) {
+        vec_remove_int(&v, vec_size(v) / 2);
+    }
+    res = res && vec_size(v) == testSize - testSize / 2 && vec_isSorted(v);
+    vec_free(v);
+    return res;
+}
+
+// check that swap and reverse work with room at the front, at the back and without room
+static int test_vec_insert_remove_2(size_t testSize) {
+    int* v = vec_create_int(0);
+    for(int i = 0; i < testSize; i++) {
+        vec_pushFront_int(&v, testSize - i - 1);
+    }
+    vec_reverse(v);
+    vec_swap(v, 0, testSize - 1);
+    int res = v[0] == 0 && v[testSize - 1] == testSize - 1;
+    for(int i = 1; res && i < testSize - 1; i++) {
+        if(v[i] != testSize - i - 1) res = 0;
+    }
+    vec_free(v);
+    v = vec_create_int(16);
+    for(int i = 0; i < 16; i++) {
+        v[i] = i;
+    }
+    vec_reverse(v);
+    for(int i = 0; res && i < 16; i++) {
+        if(v[i] != 15 - i) res = 0;
+    }
+    vec_free(v);
+    return res;
+}
+
+size_t test_vec_insert_remove(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_insert_remove_1,
+        test_vec_insert_remove_2
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING vec_insert(), vec_remove(), vec_swap() and vec_reverse()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check that the specialized sort sort random ints, with and without duplicates
+static int test_vec_typed_sort_1(size_t testSize) {
+    size_t size = testSize * 100;
+    int* v = vec_create_int(size);
+    for(int i = 0; i < size; i++) {
+        v[i] = rand();
+    }
+    vec_sort_int(v);
+    vec_setComparator(v, int_compare);
+    int res = vec_isSorted(v);
+    for(int i = 0; i < size; i++) {
+        v[i] = rand() % 4;
+    }
+    vec_sort_int(v);
+    res = res && vec_isSorted(v);
+    vec_free(v);
+    return res;
+}
+
+// check that the specialized sort sort custom structs on the given field, and keep them intact
+static int test_vec_typed_sort_2(size_t testSize) {
+    test_struct_t* v = vec_create_test_struct(testSize);
+    for(int i = 0; i < testSize; i++) {
+        v[i].a = testSize - i - 1;
+        v[i].b = v[i].a * 2.0;
+        v[i].c = 'a';
+    }
+    vec_sort_test_struct(v);
+    int res = 1;
+    for(int i = 0; res && i < testSize; i++) {
+        if(v[i].a != i || v[i].b != (float)(i * 2.0) || v[i].c != 'a') res = 0;
+    }
+    vec_free(v);
+    return res;
+}
+
+size_t test_vec_typed_sort(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_typed_sort_1,
+        test_vec_typed_sort_2
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING VEC_DEF_SORT()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check that the radix sort sort signed ints, negatives included
+static int test_vec_radix_sort_1(size_t testSize) {
+    size_t size = testSize * 100;
+    int* v = vec_create_int(size);
+    for(int i = 0; i < size; i++) {
+        v[i] = rand() - RAND_MAX / 2;
+    }
+    vec_radixSort_int(v);
+    int res = 1;
+    for(int i = 1; res && i < size; i++) {
+        if(v[i - 1] > v[i]) res = 0;
+    }
+    vec_free(v);
+    return res;
+}
+
+// check that the radix sort sort floats, negatives included
+static int test_vec_radix_sort_2(size_t testSize) {
+    size_t size = testSize * 100;
+    float* v = vec_create_float(size);
+    for(int i = 0; i < size; i++) {
+        v[i] = (float)(rand() - RAND_MAX / 2) / 1000.0f;
+    }
+    v[0] = -0.5f;
+    v[1] = 0.5f;
+    vec_radixSort_float(v);
+    int res = 1;
+    for(int i = 1; res && i < size; i++) {
+        if(v[i - 1] > v[i]) res = 0;
+    }
+    vec_free(v);
+    return res;
+}
+
+// check that the radix sort is stable, sorting on 2 keys with 2 passes
+static int test_vec_radix_sort_3(size_t testSize) {
+    test_struct_t* v = vec_create_test_struct(testSize);
+    for(int i = 0; i < testSize; i++) {
+        v[i].a = (testSize - i) % 10 - 5;
+        v[i].b = i;
+        v[i].c = 'a' + i % 3;
+    }
+    vec_radixSort_test_struct_c(v);
+    vec_radixSort_test_struct_a(v);
+    int res = 1;
+    for(int i = 1; res && i < testSize; i++) {
+        if(v[i - 1].a > v[i].a) res = 0;
+        if(v[i - 1].a == v[i].a && v[i - 1].c > v[i].c) res = 0;
+        if(v[i - 1].a == v[i].a && v[i - 1].c == v[i].c && v[i - 1].b > v[i].b) res = 0;
+    }
+    vec_free(v);
+    return res;
+}
+
+static void* failing_malloc(size_t size) {
+    return NULL;
+}
+
+// check the sort in place used when the buffer of the radix sort can't be allocated,
+// and unsigned keys
+static int test_vec_radix_sort_4(size_t testSize) {
+    size_t size = testSize * 100;
+    test_struct_t* v = vec_create_test_struct(size);
+    for(int i = 0; i < size; i++) {
+        v[i].a = rand() - RAND_MAX / 2;
+        v[i].c = rand();
+    }
+    vec_shrinkToFit(&v);
+    vec_set_allocator(failing_malloc);
+    vec_radixSort_test_struct_a(v);
+    vec_set_allocator(malloc);
+    vec_set_reallocator(realloc);
+    int res = 1;
+    for(int i = 1; res && i < size; i++) {
+        if(v[i - 1].a > v[i].a) res = 0;
+    }
+    vec_radixSort_test_struct_uc(v);
+    for(int i = 1; res && i < size; i++) {
+        if((unsigned char)v[i - 1].c > (unsigned char)v[i].c) res = 0;
+    }
+    vec_free(v);
+    return res;
+}
+
+size_t test_vec_radix_sort(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_radix_sort_1,
+        test_vec_radix_sort_2,
+        test_vec_radix_sort_3,
+        test_vec_radix_sort_4
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING VEC_DEF_RADIXSORT()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check that the parallel sort with the comparator sort the array and keep its elements
+static int test_vec_parallel_sort_1(size_t testSize) {
+    size_t size = testSize * 1000;
+    int* v = vec_create_int(size);
+    long long sum = 0;
+    for(int i = 0; i < size; i++) {
+        v[i] = rand() % 1000;
+        sum += v[i];
+    }
+    vec_setComparator(v, int_compare);
+    vec_sort_parallel(v, 8);
+    int res = vec_isSorted(v) && vec_size(v) == size;
+    for(int i = 0; i < size; i++) {
+        sum -= v[i];
+    }
+    vec_free(v);
+    return res && sum == 0;
+}
+
+// check that the specialized parallel sort sort the array, with a number of threads that is not a power of 2
+static int test_vec_parallel_sort_2(size_t testSize) {
+    size_t size = testSize * 1000 + 7;
+    int* v = vec_create_int(size);
+    for(int i = 0; i < size; i++) {
+        v[i] = rand();
+    }
+    vec_sort_parallel_int(v, 6);
+    vec_setComparator(v, int_compare);
+    int res = vec_isSorted(v);
+    vec_free(v);
+    return res;
+}
+
+size_t test_vec_parallel_sort(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_parallel_sort_1,
+        test_vec_parallel_sort_2
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING vec_sort_parallel()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check that inserting batches give the same array as inserting the values one by one
+static int test_vec_sorted_insert_n_1(size_t testSize) {
+    int* v = vec_create_int(0);
+    int* expected = vec_create_int(0);
+    int* batch = malloc(testSize * sizeof(int));
+    vec_setComparator(v, int_compare);
+    vec_setComparator(expected, int_compare);
+    for(int k = 0; k < 5; k++) {
+        for(int i = 0; i < testSize; i++) {
+            batch[i] = rand() % (testSize * 2);
+            vec_sortedInsert_int(&expected, batch[i]);
+        }
+        // batches of different sizes, to use the room at the back or an allocated buffer
+        vec_sortedInsertN_int(&v, batch, testSize / (k + 1));
+        vec_sortedInsertN_int(&v, batch + testSize / (k + 1), testSize - testSize / (k + 1));
+    }
+    int res = vec_size(v) == vec_size(expected);
+    for(int i = 0; res && i < vec_size(v); i++) {
+        if(v[i] != expected[i]) res = 0;
+    }
+    free(batch);
+    vec_free(v);
+    vec_free(expected);
+    return res;
+}
+
+size_t test_vec_sorted_insert_n(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_sorted_insert_n_1
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING vec_sortedInsertN()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check lower and upper bounds against a linear search, with duplicates and values out of the array
+static int test_vec_search_1(size_t testSize) {
+    int* v = vec_create_int(testSize);
+    for(int i = 0; i < testSize; i++) {
+        v[i] = (i / 3) * 2;
+    }
+    int res = 1;
+    for(int value = -2; res && value <= (int)testSize; value++) {
+        size_t lower = 0, upper;
+        while(lower < testSize && v[lower] < value) lower++;
+        upper = lower;
+        while(upper < testSize && v[upper] == value) upper++;
+        vec_range_t range = vec_equalRange_int(v, value);
+        if(vec_lowerBound_int(v, value) != lower || vec_upperBound_int(v, value) != upper) res = 0;
+        if(range.start != lower || range.end != upper) res = 0;
+    }
+    vec_free(v);
+    return res;
+}
+
+// check the Eytzinger search find the same elements as the lower bound on the sorted array
+static int test_vec_search_2(size_t testSize) {
+    int* v = vec_create_int(testSize);
+    for(int i = 0; i < testSize; i++) {
+        v[i] = i * 2;
+    }
+    int* eytz = vec_eytzinger_int(v);
+    int res = vec_size(eytz) == testSize;
+    for(int value = -1; res && value <= (int)testSize * 2; value++) {
+        size_t lower = vec_lowerBound_int(v, value);
+        size_t found = vec_eytzingerLowerBound_int(eytz, value);
+        if(lower == testSize) {
+            if(found != testSize) res = 0;
+        } else if(found == testSize || eytz[found] != v[lower]) {
+            res = 0;
+        }
+    }
+    vec_free(eytz);
+    vec_free(v);
+    return res;
+}
+
+size_t test_vec_search(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_search_1,
+        test_vec_search_2
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING VEC_DEF_SEARCH()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check the int kernels against simple loops, with a size that is not a multiple of the vector width
+static int test_vec_reduce_1(size_t testSize) {
+    size_t size = testSize * 10 + 3;
+    int* v = vec_create_int(size);
+    for(int i = 0; i < size; i++) {
+        v[i] = rand() % 2001 - 1000;
+    }
+    // the max is in the scalar tail
+    v[size - 1] = 5000;
+    long long sum = 0;
+    int min = v[0];
+    size_t count = 0;
+    for(int i = 0; i < size; i++) {
+        sum += v[i];
+        if(v[i] < min) min = v[i];
+        count += v[i] == 7;
+    }
+    int res = vec_sum_int(v) == sum && vec_max_int(v) == 5000 && vec_min_int(v) == min
+        && vec_count_int(v, 7) == count && vec_find_int(v, 5000) == size - 1
+        && vec_find_int(v, 9999) == size;
+    vec_free(v);
+    int* empty = vec_create_int(0);
+    res = res && vec_min_int(empty) == 0 && vec_sum_int(empty) == 0 && vec_find_int(empty, 0) == 0;
+    vec_free(empty);
+    return res;
+}
+
+// check the float kernels against simple loops
+static int test_vec_reduce_2(size_t testSize) {
+    size_t size = testSize * 10 + 5;
+    float* v = vec_create_float(size);
+    double sum = 0;
+    float min = 0, max = 0;
+    size_t count = 0;
+    for(int i = 0; i < size; i++) {
+        v[i] = (float)(rand() % 201 - 100) / 4.0f;
+        sum += v[i];
+        if(i == 0 || v[i] < min) min = v[i];
+        if(i == 0 || v[i] > max) max = v[i];
+        count += v[i] == 0.5f;
+    }
+    size_t first = 0;
+    while(first < size && v[first] != 0.5f) first++;
+    // values are multiples of 0.25, so the sum is exact whatever the order
+    int res = vec_sum_float(v) == sum && vec_min_float(v) == min && vec_max_float(v) == max
+        && vec_count_float(v, 0.5f) == count && vec_find_float(v, 0.5f) == first
+        && vec_find_float(v, 1000.0f) == size;
+    vec_free(v);
+    return res;
+}
+
+static int test_vec_reduce_3(size_t testSize) {
+    size_t size = testSize * 10 + 3;
+    double* v = vec_create_double(size);
+    double sum = 0, min = 0, max = 0;
+    size_t count = 0;
+    for(int i = 0; i < size; i++) {
+        v[i] = (double)(rand() % 201 - 100) / 4.0;
+        sum += v[i];
+        if(i == 0 || v[i] < min) min = v[i];
+        if(i == 0 || v[i] > max) max = v[i];
+        count += v[i] == 0.5;
+    }
+    size_t first = 0;
+    while(first < size && v[first] != 0.5) first++;
+    int res = vec_sum_double(v) == sum && vec_min_double(v) == min && vec_max_double(v) == max
+        && vec_count_double(v, 0.5) == count && vec_find_double(v, 0.5) == first
+        && vec_find_double(v, 1000.0) == size;
+    vec_free(v);
+    return res;
+}
+
+// values with the same low 32 bits and different high ones, to check the 64 bits comparisons
+static int test_vec_reduce_4(size_t testSize) {
+    size_t size = testSize * 10 + 3;
+    int64_t* v = vec_create_int64(size);
+    uint64_t sum = 0;
+    int64_t min = 0, max = 0, wanted = ((int64_t)3 << 32) + 7;
+    size_t count = 0;
+    for(int i = 0; i < size; i++) {
+        v[i] = (int64_t)(rand() % 11 - 5) * ((int64_t)1 << 32) + 7;
+        sum += (uint64_t)v[i];
+        if(i == 0 || v[i] < min) min = v[i];
+        if(i == 0 || v[i] > max) max = v[i];
+        count += v[i] == wanted;
+    }
+    size_t first = 0;
+    while(first < size && v[first] != wanted) first++;
+    int res = vec_sum_int64(v) == (int64_t)sum && vec_min_int64(v) == min && vec_max_int64(v) == max
+        && vec_count_int64(v, wanted) == count && vec_find_int64(v, wanted) == first
+        && vec_find_int64(v, ((int64_t)6 << 32) + 7) == size;
+    vec_view_t view = vec_view(v, 1, size);
+    res = res && vec_view_find_int64(view, v[2]) <= 1;
+    vec_free(v);
+    return res;
+}
+
+size_t test_vec_reduce(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_reduce_1,
+        test_vec_reduce_2,
+        test_vec_reduce_3,
+        test_vec_reduce_4
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING vec_find(), vec_count(), vec_min(), vec_max() and vec_sum()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check that a deque used as a queue keep the order, while wrapping around and growing
+static int test_vec_deque_1(size_t testSize) {
+    vec_deque_t* dq = vec_deque_create_int(4);
+    int res = 1, next = 0;
+    for(int i = 0; res && i < testSize * 10; i++) {
+        vec_deque_pushBack_int(dq, i);
+        // grow slowly so the elements are wrapped when the deque grows
+        if(i % 3 != 0) {
+            if(vec_deque_popFront_int(dq) != next++) res = 0;
+        }
+    }
+    res = res && vec_deque_size(dq) == testSize * 10 - next;
+    for(int i = 0; res && i < vec_deque_size(dq); i++) {
+        if(*vec_deque_at_int(dq, i) != next + i) res = 0;
+    }
+    res = res && vec_deque_at_int(dq, vec_deque_size(dq)) == NULL;
+    vec_deque_free(dq);
+    return res;
+}
+
+// check push and pop at both ends
+static int test_vec_deque_2(size_t testSize) {
+    vec_deque_t* dq = vec_deque_create_int(0);
+    for(int i = 0; i < testSize; i++) {
+        vec_deque_pushFront_int(dq, i);
+        vec_deque_pushBack_int(dq, -i);
+    }
+    int res = vec_deque_size(dq) == testSize * 2;
+    for(int i = testSize - 1; res && i >= 0; i--) {
+        if(vec_deque_popFront_int(dq) != i || vec_deque_popBack_int(dq) != -i) res = 0;
+    }
+    res = res && vec_deque_size(dq) == 0;
+    vec_deque_free(dq);
+    return res;
+}
+
+// check bulk enqueue and dequeue into a buffer
+static int test_vec_deque_3(size_t testSize) {
+    vec_deque_t* dq = vec_deque_create_int(testSize);
+    int* values = malloc(testSize * sizeof(int));
+    int* out = malloc(testSize * sizeof(int));
+    for(int i = 0; i < testSize; i++) {
+        values[i] = i;
+    }
+    int res = 1;
+    for(int k = 0; res && k < 10; k++) {
+        vec_deque_pushBackN_int(dq, values, testSize);
+        // leave some elements so the next pushes wrap
+        size_t count = vec_deque_popFrontN_int(dq, out, testSize - 3);
+        if(count != testSize - 3) res = 0;
+        for(int i = 0; res && i < count; i++) {
+            if(out[i] != (i + (testSize - 3) * k) % testSize) res = 0;
+        }
+    }
+    res = res && vec_deque_popFrontN_int(dq, out, testSize) == 30;
+    free(values);
+    free(out);
+    vec_deque_free(dq);
+    return res;
+}
+
+size_t test_vec_deque(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_deque_1,
+        test_vec_deque_2,
+        test_vec_deque_3
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING VEC_DEF_DEQUE()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check that eraseRange remove the right elements near the front, near the back and at the end
+static int test_vec_erase_1(size_t testSize) {
+    int* v = vec_create_int(testSize);
+    for(int i = 0; i < testSize; i++) {
+        v[i] = i;
+    }
+    // [0, 10) near the front, then [size - 20, size - 10) near the back
+    vec_eraseRange_int(&v, 0, 10);
+    vec_eraseRange_int(&v, testSize - 30, testSize - 20);
+    int res = vec_size(v) == testSize - 20;
+    for(int i = 0; res && i < vec_size(v); i++) {
+        int expected = i < testSize - 30 ? i + 10 : i + 20;
+        if(v[i] != expected) res = 0;
+    }
+    vec_eraseRange_int(&v, 5, (size_t)-1);
+    res = res && vec_size(v) == 5 && v[4] == 14;
+    vec_free(v);
+    return res;
+}
+
+static int keep_even(const void* a, void* ctx) {
+    return *(const int*)a % 2 == 0;
+}
+
+// check that retain and removeIf keep the right elements in order
+static int test_vec_erase_2(size_t testSize) {
+    int* v = vec_create_int(testSize);
+    for(int i = 0; i < testSize; i++) {
+        v[i] = i;
+    }
+    int res = vec_retain(&v, keep_even, NULL) == testSize / 2;
+    int three = 3;
+    size_t removed = vec_removeIf_multiple(&v, &three);
+    res = res && removed == (testSize + 5) / 6 && vec_size(v) == testSize / 2 - removed;
+    for(int i = 0, expected = 0; res && i < vec_size(v); i++, expected += 2) {
+        if(expected % 3 == 0) expected += 2;
+        if(v[i] != expected) res = 0;
+    }
+    vec_free(v);
+    return res;
+}
+
+static int keep_counted(const void* a, void* ctx) {
+    (*(size_t*)ctx)++;
+    return *(const int*)a % 4 < 2;
+}
+
+// check that retain call the predicate once per element
+static int test_vec_erase_3(size_t testSize) {
+    int* v = vec_create_int(testSize);
+    for(int i = 0; i < testSize; i++) {
+        v[i] = i;
+    }
+    size_t calls = 0;
+    int res = vec_retain(&v, keep_counted, &calls) == testSize / 2 && calls == testSize;
+    for(int i = 0; res && i < vec_size(v); i++) {
+        if(v[i] != i / 2 * 4 + i % 2) res = 0;
+    }
+    vec_free(v);
+    return res;
+}
+
+size_t test_vec_erase(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_erase_1,
+        test_vec_erase_2,
+        test_vec_erase_3
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING vec_eraseRange(), vec_retain() and VEC_DEF_REMOVE_IF()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+// check the bounds of views and sub views, the accessors and the copy to a new array
+static int test_vec_view_1(size_t testSize) {
+    int* v = vec_create_int(testSize);
+    for(int i = 0; i < testSize; i++) {
+        v[i] = i;
+    }
+    vec_view_t view = vec_view(v, 10, testSize - 10);
+    vec_view_t sub = vec_view_sub(view, 5, (size_t)-1);
+    vec_view_t empty = vec_view(v, testSize, testSize + 5);
+    int res = view.size == testSize - 20 && sub.size == testSize - 25 && empty.size == 0;
+    res = res && vec_view_get_int(sub, 0) == 15 && *(int*)vec_view_at(view, 0) == 10;
+    res = res && vec_view_at(view, view.size) == NULL && vec_view_at(empty, 0) == NULL;
+    // writes through the view are seen in the array
+    vec_view_set_int(sub, 1, -1);
+    res = res && v[16] == -1;
+    int* copy = vec_view_toVec(sub);
+    res = res && copy != NULL && vec_size(copy) == sub.size;
+    for(size_t i = 0; res && i < sub.size; i++) {
+        if(copy[i] != vec_view_data_int(sub)[i]) res = 0;
+    }
+    vec_free(copy);
+    vec_free(v);
+    return res;
+}
+
+// sort the middle of an array with every sort and check the rest is untouched, then search in the view
+static int test_vec_view_2(size_t testSize) {
+    int* v = vec_create_int(testSize);
+    size_t start = testSize / 4, end = testSize - testSize / 4;
+    int res = 1;
+    for(int sort = 0; res && sort < 4; sort++) {
+        for(int i = 0; i < testSize; i++) {
+            v[i] = testSize - i;
+        }
+        vec_view_t view = vec_view(v, start, end);
+        switch(sort) {
+            case 0: vec_view_sort_int(view); break;
+            case 1: vec_view_radixSort_int(view); break;
+            case 2: vec_view_sort_parallel_int(view, 4); break;
+            default: vec_view_qsort(view, int_compare); break;
+        }
+        for(size_t i = 0; res && i < testSize; i++) {
+            // the view is reversed, so i in the view go to start + end - 1 - i
+            int expected = i < start || i >= end ? testSize - i : testSize - (start + end - 1 - i);
+            if(v[i] != expected) res = 0;
+        }
+        res = res && vec_view_lowerBound_int(view, v[start + 3]) == 3;
+        res = res && vec_view_upperBound_int(view, v[start]) == 1;
+    }
+    vec_free(v);
+    return res;
+}
+
+// check the reductions only see the elements of the view
+static int test_vec_view_3(size_t testSize) {
+    int* v = vec_create_int(testSize);
+    for(int i = 0; i < testSize; i++) {
+        v[i] = i;
+    }
+    vec_view_t view = vec_view(v, 10, 20);
+    int res = vec_view_min_int(view) == 10 && vec_view_max_int(view) == 19;
+    res = res && vec_view_sum_int(view) == 145 && vec_view_count_int(view, 5) == 0;
+    res = res && vec_view_find_int(view, 12) == 2 && vec_view_find_int(view, 25) == view.size;
+    vec_free(v);
+    return res;
+}
+
+size_t test_vec_view(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_view_1,
+        test_vec_view_2,
+        test_vec_view_3
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING vec_view()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+typedef struct {
+    size_t allocs;
+    size_t frees;
+    size_t reallocs;
+    size_t bytes; // currently allocated
+} counting_ctx_t;
+
+static void* counting_alloc(void* ctx, size_t size) {
+    counting_ctx_t* c = ctx;
+    c->allocs++;
+    c->bytes += size;
+    return malloc(size);
+}
+
+static void counting_free(void* ctx, void* ptr, size_t size) {
+    counting_ctx_t* c = ctx;
+    c->frees++;
+    c->bytes -= size;
+    free(ptr);
+}
+
+// check that a custom allocator receive its context and the right sizes, through resizes and free
+static int test_vec_allocator_1(size_t testSize) {
+    counting_ctx_t ctx = { 0, 0, 0, 0 };
+    vec_allocator_t counting = { counting_alloc, NULL, counting_free, &ctx };
+    int* v = vec_create_with_allocator_int(0, &counting);
+    int res = vec_getAllocator(v) == &counting && ctx.allocs == 1;
+    for(int i = 0; i < testSize; i++) {
+        vec_pushBack_int(&v, i);
+    }
+    for(int i = 0; i < testSize / 2; i++) {
+        vec_popFront_int(&v);
+    }
+    res = res && ctx.allocs > 1 && ctx.allocs == ctx.frees + 1;
+    for(int i = 0; res && i < vec_size(v); i++) {
+        if(v[i] != i + testSize / 2) res = 0;
+    }
+    vec_free(v);
+    return res && ctx.allocs == ctx.frees && ctx.bytes == 0;
+}
+
+static void* counting_realloc(void* ctx, void* ptr, size_t oldSize, size_t newSize) {
+    counting_ctx_t* c = ctx;
+    c->reallocs++;
+    c->bytes += newSize - oldSize;
+    return realloc(ptr, newSize);
+}
+
+// check that the resizes use realloc only when the elements are at the start of the array,
+// and that an array alone in an arena grow in place
+static int test_vec_allocator_4(size_t testSize) {
+    counting_ctx_t ctx = { 0, 0, 0, 0 };
+    vec_allocator_t counting = { counting_alloc, counting_realloc, counting_free, &ctx };
+    int* v = vec_create_with_allocator_int(0, &counting);
+    for(int i = 0; i < testSize; i++) {
+        vec_pushBack_int(&v, i);
+    }
+    // only grown with realloc
+    int res = ctx.allocs == 1 && ctx.frees == 0 && ctx.reallocs > 0;
+    // with an element removed at the front, the elements are not at the start of the array anymore
+    vec_popFront_int(&v);
+    // so the next resize move them to a new block, and the following ones use realloc again
+    for(int i = 0; i < testSize * 2; i++) {
+        vec_pushBack_int(&v, testSize + i);
+    }
+    res = res && ctx.allocs == 2 && ctx.frees == 1;
+    for(int i = 0; res && i < vec_size(v); i++) {
+        if(v[i] != i + 1) res = 0;
+    }
+    vec_free(v);
+    res = res && ctx.bytes == 0;
+
+    vec_arena_t* arena = vec_arena_create((size_t)1 << 20);
+    int* a = vec_create_with_allocator_int(0, vec_arena_allocator(arena));
+    int* front = a;
+    for(int i = 0; i < testSize; i++) {
+        vec_pushBack_int(&a, i);
+    }
+    res = res && a == front && a[testSize - 1] == testSize - 1;
+    vec_arena_free(arena);
+    return res;
+}
+
+// grow an array big enough to be mapped directly, the elements need to follow the mapping when it's remapped
+static int test_vec_allocator_5(size_t testSize) {
+    size_t size = (size_t)1 << 23;
+    int* v = vec_create_int(0);
+    vec_allocate(&v, size, 1);
+    for(size_t i = 0; i < size; i++) {
+        v[i] = i;
+    }
+    vec_allocate(&v, size * 2, 0);
+    for(int i = 0; i < testSize; i++) {
+        vec_pushBack_int(&v, i);
+    }
+    int res = vec_size(v) == size + testSize;
+    for(size_t i = 0; res && i < size; i++) {
+        if(v[i] != i) res = 0;
+    }
+    vec_free(v);
+    return res;
+}
+
+// fill arrays from an arena, reset it and fill them again in the same memory
+static int test_vec_allocator_2(size_t testSize) {
+    vec_arena_t* arena = vec_arena_create(1024);
+    int res = arena != NULL;
+    int* first = NULL;
+    for(int round = 0; res && round < 3; round++) {
+        int* a = vec_create_with_allocator_int(0, vec_arena_allocator(arena));
+        int* b = vec_create_with_allocator_int(0, vec_arena_allocator(arena));
+        for(int i = 0; i < testSize; i++) {
+            vec_pushBack_int(&a, i);
+            vec_pushFront_int(&b, i);
+        }
+        res = vec_size(a) == testSize && vec_size(b) == testSize;
+        for(int i = 0; res && i < testSize; i++) {
+            if(a[i] != i || b[i] != testSize - 1 - i) res = 0;
+        }
+        // the memory is reused after a reset
+        if(round == 0) first = a;
+        else if(a != first) res = 0;
+        vec_arena_reset(arena);
+    }
+    vec_arena_free(arena);
+    return res;
+}
+
+// create and free lots of arrays of different sizes from a pool
+static int test_vec_allocator_3(size_t testSize) {
+    vec_pool_t* pool = vec_pool_create();
+    int res = pool != NULL;
+    int* vecs[8];
+    for(int round = 0; res && round < 4; round++) {
+        for(int j = 0; j < 8; j++) {
+            vecs[j] = vec_create_with_allocator_int(j, vec_pool_allocator(pool));
+            for(int i = 0; i < testSize * j; i++) {
+                vec_pushBack_int(&vecs[j], i + j);
+            }
+        }
+        for(int j = 0; j < 8; j++) {
+            if(vec_size(vecs[j]) != j + testSize * j) res = 0;
+            for(int i = 0; res && i < testSize * j; i++) {
+                if(vecs[j][i + j] != i + j) res = 0;
+            }
+            vec_free(vecs[j]);
+        }
+    }
+    vec_pool_free(pool);
+    return res;
+}
+
+static size_t libFrees = 0;
+
+static void lib_free(void* ptr) {
+    libFrees++;
+    free(ptr);
+}
+
+// check that big arrays are freed by the functions they were allocated with,
+// when the functions of the library change in between
+static int test_vec_allocator_6(size_t testSize) {
+    // mapped when malloc and free are the functions of the library
+    int* mapped = vec_create_int(((size_t)1 << 26) / sizeof(int));
+    int* resized = vec_create_int(((size_t)1 << 26) / sizeof(int));
+    vec_set_deallocator(lib_free);
+    libFrees = 0;
+    vec_free(mapped);
+    int res = libFrees == 0;
+    // the smaller block come from the new functions, and the mapping is unmapped
+    vec_eraseRange_int(&resized, testSize, (size_t)-1);
+    res = res && vec_size(resized) == testSize && libFrees == 0;
+    vec_free(resized);
+    res = res && libFrees == 1;
+    // not mapped as malloc isn't the allocator of the library, so freed with free
+    vec_set_allocator(malloc);
+    int* notMapped = vec_create_int(((size_t)1 << 26) / sizeof(int));
+    vec_set_deallocator(free);
+    vec_free(notMapped);
+    vec_set_reallocator(realloc);
+    return res && libFrees == 1;
+}
+
+size_t test_vec_allocator(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_allocator_1,
+        test_vec_allocator_2,
+        test_vec_allocator_3,
+        test_vec_allocator_4,
+        test_vec_allocator_5,
+        test_vec_allocator_6
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING vec_create_with_allocator(), vec_arena_t and vec_pool_t\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+#define is_aligned(ptr, align) (((uintptr_t)(ptr) & ((align) - 1)) == 0)
+
+// apply random operations to an aligned array and an unaligned one,
+// check the alignment after each operation, and that both arrays stay the same
+static int test_vec_aligned_common(size_t testSize, size_t align) {
+    int* v = vec_create_aligned_int(0, align);
+    int* ref = vec_create_int(0);
+    int values[3] = { 1, 2, 3 };
+    int res = is_aligned(v, align);
+    srand(align);
+    for(size_t i = 0; res && i < testSize * 20; i++) {
+        size_t size = vec_size(ref);
+        size_t index = size ? rand() % size : 0;
+        switch(rand() % 10) {
+            case 0: case 1: vec_pushBack_int(&v, i); vec_pushBack_int(&ref, i); break;
+            case 2: case 3: vec_pushFront_int(&v, i); vec_pushFront_int(&ref, i); break;
+            case 4: vec_popFront_int(&v); vec_popFront_int(&ref); break;
+            case 5: vec_popBack_int(&v); vec_popBack_int(&ref); break;
+            case 6: vec_insert_int(&v, index, i); vec_insert_int(&ref, index, i); break;
+            case 7: vec_insertRange_int(&v, index, values, 3); vec_insertRange_int(&ref, index, values, 3); break;
+            case 8: vec_pushFrontN_int(&v, values, 3); vec_pushFrontN_int(&ref, values, 3); break;
+            default:
+                vec_eraseRange_int(&v, index / 2, index); vec_eraseRange_int(&ref, index / 2, index);
+                if(size) {
+                    vec_remove_int(&v, 0); vec_remove_int(&ref, 0);
+                }
+                break;
+        }
+        res = is_aligned(v, align) && vec_size(v) == vec_size(ref) && memcmp(v, ref, vec_size(v) * sizeof(int)) == 0;
+    }
+    vec_clear_int(&v);
+    res = res && is_aligned(v, align);
+    vec_free(v);
+    vec_free(ref);
+    return res;
+}
+
+static int test_vec_aligned_1(size_t testSize) {
+    return test_vec_aligned_common(testSize, 32);
+}
+
+static int test_vec_aligned_2(size_t testSize) {
+    return test_vec_aligned_common(testSize, 64);
+}
+
+// elements of 12 bytes, the front keep its alignment when moving by 4 elements, and for a big array
+static int test_vec_aligned_3(size_t testSize) {
+    test_struct_t* v = vec_create_aligned_test_struct(0, 16);
+    int res = v != NULL && vec_create_aligned(4, 0, 24) == NULL;
+    for(int i = 0; res && i < testSize; i++) {
+        test_struct_t value = { i, 0, 0 };
+        vec_pushFront_test_struct(&v, value);
+        res = is_aligned(v, 16);
+    }
+    for(int i = 0; res && i < testSize / 2; i++) {
+        vec_popFront_test_struct(&v);
+        res = is_aligned(v, 16) && v[0].a == testSize - 2 - i;
+    }
+    vec_free(v);
+    int* big = vec_create_aligned_int(0, 64);
+    vec_allocate(&big, (size_t)1 << 23, 1);
+    res = res && is_aligned(big, 64);
+    big[0] = 42;
+    vec_allocate(&big, (size_t)1 << 24, 0);
+    res = res && is_aligned(big, 64) && big[0] == 42;
+    vec_free(big);
+    return res;
+}
+
+size_t test_vec_aligned(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_aligned_1,
+        test_vec_aligned_2,
+        test_vec_aligned_3
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING vec_create_aligned()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// the counters only exist when the library is compiled with VEC_STATS (make STATS=1),
+// else they should all be zeros
+#ifndef VEC_STATS
+static int stats_are_zero(vec_stats_t stats) {
+    return stats.resizes == 0 && stats.bytesCopied == 0 && stats.bytesMoved == 0 && stats.bytesRebased == 0
+        && stats.allocatedBytes == 0 && stats.peakBytes == 0 && stats.allocFailures == 0;
+}
+#endif
+
+// check the counters of an array growing at the back and the front
+static int test_vec_stats_1(size_t testSize) {
+    vec_resetStats();
+    vec_stats_t before = vec_getStats(NULL);
+    int* v = vec_create_int(testSize);
+    // full, so the first push to the front grow the array then move the elements to the back
+    vec_pushFront_int(&v, 0);
+    vec_stats_t stats = vec_getStats(v);
+#ifdef VEC_STATS
+    int res = stats.resizes == 1 && stats.bytesRebased == testSize * sizeof(int);
+    res = res && stats.allocatedBytes > vec_capacity(v) * sizeof(int) && stats.peakBytes >= stats.allocatedBytes;
+    for(int i = 0; i < testSize; i++) {
+        vec_pushBack_int(&v, i);
+    }
+    vec_insert_int(&v, 1, 0);
+    stats = vec_getStats(v);
+    res = res && stats.resizes > 1 && stats.bytesCopied >= testSize * sizeof(int) && stats.bytesMoved >= sizeof(int);
+    vec_stats_t global = vec_getStats(NULL);
+    res = res && global.resizes == before.resizes + stats.resizes
+        && global.allocatedBytes == before.allocatedBytes + stats.allocatedBytes;
+    vec_free(v);
+    res = res && vec_getStats(NULL).allocatedBytes == before.allocatedBytes;
+#else
+    int res = stats_are_zero(stats) && stats_are_zero(before);
+    vec_free(v);
+#endif
+    return res;
+}
+
+// check the peak is kept when the array shrink
+static int test_vec_stats_2(size_t testSize) {
+    int* v = vec_create_int(0);
+    for(int i = 0; i < testSize * 10; i++) {
+        vec_pushBack_int(&v, i);
+    }
+    for(int i = 0; i < testSize * 10; i++) {
+        vec_popBack_int(&v);
+    }
+    vec_stats_t stats = vec_getStats(v);
+#ifdef VEC_STATS
+    int res = stats.peakBytes >= testSize * 10 * sizeof(int) && stats.allocatedBytes < stats.peakBytes;
+#else
+    int res = stats_are_zero(stats);
+#endif
+    vec_free(v);
+    return res;
+}
+
+size_t test_vec_stats(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_stats_1,
+        test_vec_stats_2
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING vec_getStats()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check that the elements never move while the segmented array grows
+static int test_vec_segvec_1(size_t testSize) {
+    vec_segvec_t* sv = vec_segvec_create_int(8);
+    int* first = vec_segvec_pushBack_int(sv, 0);
+    int* ninth = NULL;
+    for(int i = 1; i < testSize * 50; i++) {
+        int* elem = vec_segvec_pushBack_int(sv, i);
+        if(i == 8) ninth = elem;
+    }
+    int res = vec_segvec_chunkSize(sv) == 8 && vec_segvec_size(sv) == testSize * 50;
+    res = res && first == vec_segvec_at_int(sv, 0) && ninth == vec_segvec_at_int(sv, 8);
+    res = res && *first == 0 && *ninth == 8;
+    for(int i = 0; res && i < testSize * 50; i++) {
+        if(*vec_segvec_at_int(sv, i) != i) res = 0;
+    }
+    res = res && vec_segvec_at_int(sv, testSize * 50) == NULL;
+    vec_segvec_free(sv);
+    return res;
+}
+
+// check bulk pushes across chunk boundaries and the iteration chunk by chunk
+static int test_vec_segvec_2(size_t testSize) {
+    vec_segvec_t* sv = vec_segvec_create_int(5);
+    int values[testSize];
+    for(int i = 0; i < testSize; i++) {
+        values[i] = i;
+    }
+    vec_segvec_pushBack_int(sv, -1);
+    vec_segvec_pushBackN_int(sv, values, testSize);
+    vec_segvec_pushBackN_int(sv, values, testSize);
+    int res = vec_segvec_chunkSize(sv) == 8 && vec_segvec_size(sv) == testSize * 2 + 1;
+    size_t total = 0, count;
+    int* chunk;
+    for(size_t c = 0; res && (chunk = vec_segvec_chunk_int(sv, c, &count)) != NULL; c++) {
+        if(count == 0 || count > 8) res = 0;
+        for(size_t i = 0; res && i < count; i++, total++) {
+            int expected = total == 0 ? -1 : (total - 1) % testSize;
+            if(chunk[i] != expected) res = 0;
+        }
+    }
+    res = res && total == testSize * 2 + 1 && count == 0;
+    vec_segvec_free(sv);
+    return res;
+}
+
+// check popBack, clear and reuse after clear
+static int test_vec_segvec_3(size_t testSize) {
+    vec_segvec_t* sv = vec_segvec_create_int(0);
+    for(int i = 0; i < testSize * 20; i++) {
+        vec_segvec_pushBack_int(sv, i);
+    }
+    int res = vec_segvec_chunkSize(sv) == 1024;
+    for(int i = testSize * 20 - 1; res && i >= testSize; i--) {
+        if(vec_segvec_popBack_int(sv) != i) res = 0;
+    }
+    res = res && vec_segvec_size(sv) == testSize;
+    vec_segvec_clear(sv);
+    res = res && vec_segvec_size(sv) == 0 && vec_segvec_at_int(sv, 0) == NULL;
+    for(int i = 0; i < testSize; i++) {
+        vec_segvec_pushBack_int(sv, i * 2);
+    }
+    for(int i = 0; res && i < testSize; i++) {
+        if(*vec_segvec_at_int(sv, i) != i * 2) res = 0;
+    }
+    vec_segvec_free(sv);
+    return res;
+}
+
+size_t test_vec_segvec(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_segvec_1,
+        test_vec_segvec_2,
+        test_vec_segvec_3
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING VEC_DEF_SEGVEC()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+static size_t cacheMallocs = 0;
+static size_t cacheFrees = 0;
+
+static void* cache_malloc(size_t size) {
+    cacheMallocs++;
+    return malloc(size);
+}
+
+static void cache_free(void* ptr) {
+    cacheFrees++;
+    free(ptr);
+}
+
+// use counting functions as allocator of the library
+static void cache_setCounting(void) {
+    vec_set_allocator(cache_malloc);
+    vec_set_deallocator(cache_free);
+    vec_set_reallocator(realloc);
+    cacheMallocs = 0;
+    cacheFrees = 0;
+}
+
+static void cache_restore(void) {
+    vec_cache_setLimits(0, 0, 0);
+    vec_set_allocator(malloc);
+    vec_set_deallocator(free);
+    vec_set_reallocator(realloc);
+}
+
+// check that arrays created and freed in a loop reuse the cached blocks
+static int test_vec_cache_1(size_t testSize) {
+    cache_setCounting();
+    vec_cache_setLimits(4, 1 << 20, 1 << 16);
+    for(int i = 0; i < testSize; i++) {
+        int* a = vec_create_int(0);
+        int* b = vec_create_int(16);
+        vec_pushBack_int(&a, i);
+        vec_free(b);
+        vec_free(a);
+    }
+    // at most the first iteration call malloc, and everything is cached
+    int res = cacheMallocs <= 2 && cacheFrees == 0;
+    size_t mallocs = cacheMallocs;
+    vec_cache_trim();
+    res = res && cacheFrees == mallocs;
+    int* v = vec_create_int(0);
+    res = res && cacheMallocs == mallocs + 1;
+    vec_free(v);
+    cache_restore();
+    return res;
+}
+
+// check the limits of the cache, and that resized arrays keep their elements with cached blocks
+static int test_vec_cache_2(size_t testSize) {
+    cache_setCounting();
+    vec_cache_setLimits(2, 1 << 20, 1 << 12);
+    int* arrs[4];
+    for(int i = 0; i < 4; i++) {
+        arrs[i] = vec_create_int(0);
+    }
+    for(int i = 0; i < 4; i++) {
+        vec_free(arrs[i]);
+    }
+    // only 2 blocks of the same class are kept
+    int res = cacheFrees == 2;
+    // blocks bigger than the max block size are not cached
+    int* big = vec_create_int(2000);
+    vec_free(big);
+    res = res && cacheFrees == 3;
+    // pops at the front force the resizes to move the elements to new blocks
+    int* v = vec_create_int(0);
+    for(int i = 0; i < testSize * 4; i++) {
+        vec_pushBack_int(&v, i);
+    }
+    for(int i = 0; i < testSize * 3; i++) {
+        vec_popFront_int(&v);
+    }
+    res = res && vec_size(v) == testSize;
+    for(int i = 0; res && i < testSize; i++) {
+        if(v[i] != testSize * 3 + i) res = 0;
+    }
+    vec_free(v);
+    cache_restore();
+    return res;
+}
+
+size_t test_vec_cache(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_cache_1,
+        test_vec_cache_2
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING vec_cache_setLimits()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check the parallel map to a new array, to a given array and in place, with and without a pool
+static int test_vec_parallel_1(size_t testSize) {
+    vec_threadPool_t* pool = vec_threadPool_create(4);
+    size_t n = testSize * 1000;
+    int* v = vec_create_int(n);
+    for(int i = 0; i < n; i++) {
+        v[i] = i;
+    }
+    float factor = 0.5f;
+    float* halves = vec_parallelMap_half(pool, v, NULL, &factor);
+    int res = vec_threadPool_size(pool) == 4 && vec_size(halves) == n;
+    for(int i = 0; res && i < n; i++) {
+        if(halves[i] != i / 2.0f + i * factor) res = 0;
+    }
+    // a smaller and a bigger output array are resized
+    float* small = vec_create_float(3);
+    float* big = vec_create_float(n * 2);
+    vec_parallelMap_half(pool, v, &small, &factor);
+    vec_parallelMap_half(NULL, v, &big, &factor);
+    res = res && vec_size(small) == n && vec_size(big) == n;
+    res = res && memcmp(small, halves, n * sizeof(float)) == 0 && memcmp(big, halves, n * sizeof(float)) == 0;
+    vec_parallelMap_twice(pool, v, &v, NULL);
+    for(int i = 0; res && i < n; i++) {
+        if(v[i] != i * 2) res = 0;
+    }
+    vec_free(halves);
+    vec_free(small);
+    vec_free(big);
+    vec_free(v);
+    vec_threadPool_free(pool);
+    return res;
+}
+
+// check that the parallel filter keep the order, to a new array and in place
+static int test_vec_parallel_2(size_t testSize) {
+    vec_threadPool_t* pool = vec_threadPool_create(3);
+    size_t n = testSize * 1000;
+    int* v = vec_create_int(n);
+    for(int i = 0; i < n; i++) {
+        v[i] = i;
+    }
+    int divisor = 3;
+    int* multiples = vec_parallelFilter_multiple(pool, v, NULL, &divisor);
+    int res = vec_size(multiples) == (n + 2) / 3;
+    for(int i = 0; res && i < vec_size(multiples); i++) {
+        if(multiples[i] != i * 3) res = 0;
+    }
+    divisor = 7;
+    vec_parallelFilter_multiple(pool, v, &v, &divisor);
+    res = res && vec_size(v) == (n + 6) / 7;
+    for(int i = 0; res && i < vec_size(v); i++) {
+        if(v[i] != i * 7) res = 0;
+    }
+    // small arrays are filtered by the calling thread
+    int* small = vec_create_int(0);
+    for(int i = 0; i < testSize; i++) {
+        vec_pushBack_int(&small, i);
+    }
+    size_t capacity = vec_capacity(multiples);
+    vec_parallelFilter_multiple(pool, small, &multiples, &divisor);
+    res = res && vec_size(multiples) == (testSize + 6) / 7 && multiples[1] == 7;
+    res = res && vec_capacity(multiples) == capacity;
+    vec_free(small);
+    vec_free(multiples);
+    vec_free(v);
+    vec_threadPool_free(pool);
+    return res;
+}
+
+// check the parallel reduce
+static int test_vec_parallel_3(size_t testSize) {
+    vec_threadPool_t* pool = vec_threadPool_create(0);
+    size_t n = testSize * 1000;
+    int* v = vec_create_int(n);
+    long long expected = 0;
+    for(int i = 0; i < n; i++) {
+        v[i] = (i * 7919) % 10007;
+        expected += v[i];
+    }
+    int res = vec_parallelReduce_sum(pool, v, 0, NULL) == expected;
+    res = res && vec_parallelReduce_sum(NULL, v, 0, NULL) == expected;
+    res = res && vec_parallelReduce_max(pool, v, -1, NULL) == 10006;
+    res = res && vec_parallelReduce_sum(pool, NULL, 0, NULL) == 0;
+    vec_free(v);
+    vec_threadPool_free(pool);
+    return res;
+}
+
+// check that a loop started from a part of another loop on the same pool is run serially instead of waiting forever
+static int test_vec_parallel_4(size_t testSize) {
+    vec_threadPool_t* pool = vec_threadPool_create(4);
+    size_t n = 4 * 4096;
+    int* v = vec_create_int(n);
+    int* inner = vec_create_int(n);
+    for(int i = 0; i < n; i++) {
+        v[i] = i;
+        inner[i] = 1;
+    }
+    test_nested_t ctx = { pool, inner };
+    int* out = vec_parallelMap_nested(pool, v, NULL, &ctx);
+    int res = out != NULL && vec_size(out) == n;
+    for(int i = 0; res && i < n; i++) {
+        if(out[i] != (i % 4096 == 0 ? n : i)) res = 0;
+    }
+    vec_free(out);
+    vec_free(inner);
+    vec_free(v);
+    vec_threadPool_free(pool);
+    return res;
+}
+
+size_t test_vec_parallel(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_parallel_1,
+        test_vec_parallel_2,
+        test_vec_parallel_3,
+        test_vec_parallel_4
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING VEC_DEF_PARALLEL_MAP(), VEC_DEF_PARALLEL_FILTER() and VEC_DEF_PARALLEL_REDUCE()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check a pipeline of 3 stages, with skip and take, collected in a new array and appended to an array
+static int test_vec_pipe_1(size_t testSize) {
+    int* v = vec_create_int(testSize);
+    for(int i = 0; i < testSize; i++) {
+        v[i] = i;
+    }
+    int divisor = 3;
+    // multiples of 3, halved, at least 10: 10.5, 12, 13.5...
+    vec_pipe_t pipe = vec_pipe(v, &divisor);
+    float* res = vec_pipe_collect_bigMultipleHalf(&pipe, NULL);
+    size_t expected = 0;
+    for(int i = 0; i < testSize; i++) {
+        if(i % 3 == 0 && i >= 20) expected++;
+    }
+    int ok = vec_size(res) == expected && res[0] == 10.5f && res[1] == 12.0f;
+    pipe = vec_pipe(v, &divisor);
+    vec_pipe_skip(&pipe, 2);
+    vec_pipe_take(&pipe, 3);
+    vec_pipe_collect_bigMultipleHalf(&pipe, &res);
+    ok = ok && vec_size(res) == expected + 3;
+    ok = ok && res[expected] == 13.5f && res[expected + 1] == 15.0f && res[expected + 2] == 16.5f;
+    ok = ok && !vec_pipe_next_bigMultipleHalf(&pipe, res);
+    vec_free(res);
+    vec_free(v);
+    return ok;
+}
+
+// check the reduce, count and foreach sinks, and a pipeline on a view
+static int test_vec_pipe_2(size_t testSize) {
+    int* v = vec_create_int(testSize);
+    int sum = 0;
+    for(int i = 0; i < testSize; i++) {
+        v[i] = i;
+        if(i % 5 == 0) sum += i;
+    }
+    int divisor = 5;
+    vec_pipe_t pipe = vec_pipe(v, &divisor);
+    int res = vec_pipe_reduce_multipleSum(&pipe, 0) == sum;
+    pipe = vec_pipe(v, &divisor);
+    res = res && vec_pipe_reduce_multipleScaled(&pipe, 1) == 1 + (long long)sum * divisor;
+    pipe = vec_view_pipe(vec_view(v, 10, 20), &divisor);
+    res = res && vec_pipe_count_multiple(&pipe) == 2;
+    pipe = vec_pipe(v, &divisor);
+    vec_pipe_take(&pipe, 4);
+    int expected = 0;
+    vec_pipe_foreach(pipe, multiple, int, val,
+        if(val != expected) res = 0;
+        expected += 5;
+    )
+    // the loop advanced the pipeline, there is nothing left in it
+    res = res && expected == 20 && vec_pipe_count_multiple(&pipe) == 0;
+    pipe = vec_pipe(NULL, &divisor);
+    res = res && vec_pipe_count_multiple(&pipe) == 0;
+    vec_free(v);
+    return res;
+}
+
+// check that vec_foreach and vec_foreach_reverse visit every element once, and handle empty arrays
+static int test_vec_pipe_3(size_t testSize) {
+    int* v = vec_create_int(testSize);
+    for(int i = 0; i < testSize; i++) {
+        v[i] = i;
+    }
+    int res = 1;
+    size_t count = 0;
+    vec_foreach(v, int, i, val,
+        if(val != i) res = 0;
+        count++;
+    )
+    vec_foreach_reverse(v, int, i, val,
+        if(val != i || val != testSize - 1 - (count - testSize)) res = 0;
+        count++;
+    )
+    res = res && count == testSize * 2;
+    int* empty = vec_create_int(0);
+    vec_foreach_reverse(empty, int, i, val,
+        if(val >= 0) res = 0;
+    )
+    vec_free(empty);
+    vec_free(v);
+    return res;
+}
+
+size_t test_vec_pipe(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_pipe_1,
+        test_vec_pipe_2,
+        test_vec_pipe_3
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING VEC_DEF_PIPELINE()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+static int* set_fromArray(const int* values, size_t count) {
+    int* v = vec_create_int(0);
+    vec_pushBackN_int(&v, values, count);
+    return v;
+}
+
+static int set_equals(const int* v, const int* values, size_t count) {
+    return vec_size(v) == count && memcmp(v, values, count * sizeof(int)) == 0;
+}
+
+// check the set operations against a count of each value, with the output array reused
+static int test_vec_set_1(size_t testSize) {
+    int* a = vec_create_int(0);
+    int* b = vec_create_int(0);
+    for(int i = 0; i < testSize * 3; i++) {
+        if(i % 2 == 0) vec_pushBack_int(&a, i);
+        if(i % 3 == 0) vec_pushBack_int(&b, i);
+    }
+    int* out = vec_setUnion_int(a, b, NULL);
+    int res = 1;
+    size_t k = 0;
+    for(int i = 0; res && i < testSize * 3; i++) {
+        if((i % 2 == 0 || i % 3 == 0) && out[k++] != i) res = 0;
+    }
+    res = res && vec_size(out) == k;
+    vec_setIntersection_int(a, b, &out);
+    k = 0;
+    for(int i = 0; res && i < testSize * 3; i++) {
+        if(i % 6 == 0 && out[k++] != i) res = 0;
+    }
+    res = res && vec_size(out) == k;
+    vec_setDifference_int(a, b, &out);
+    k = 0;
+    for(int i = 0; res && i < testSize * 3; i++) {
+        if(i % 2 == 0 && i % 3 != 0 && out[k++] != i) res = 0;
+    }
+    res = res && vec_size(out) == k;
+    vec_setSymmetricDifference_int(a, b, &out);
+    k = 0;
+    for(int i = 0; res && i < testSize * 3; i++) {
+        if((i % 2 == 0) != (i % 3 == 0) && out[k++] != i) res = 0;
+    }
+    res = res && vec_size(out) == k;
+    vec_free(out);
+    vec_free(a);
+    vec_free(b);
+    return res;
+}
+
+// check the operations between a small and a big array, done with exponential searches
+static int test_vec_set_2(size_t testSize) {
+    int* big = vec_create_int(testSize * 100);
+    for(int i = 0; i < testSize * 100; i++) {
+        big[i] = i * 2;
+    }
+    int small[] = { -1, 0, 2, 3, 500, 501, (int)testSize * 100 - 2, (int)testSize * 200 - 2, (int)testSize * 200 };
+    size_t nsmall = sizeof(small) / sizeof(small[0]);
+    int* s = set_fromArray(small, nsmall);
+    int* out = vec_setIntersection_int(big, s, NULL);
+    int expected[] = { 0, 2, 500, (int)testSize * 100 - 2, (int)testSize * 200 - 2 };
+    int res = set_equals(out, expected, 5);
+    vec_setIntersection_int(s, big, &out);
+    res = res && set_equals(out, expected, 5);
+    vec_setUnion_int(s, big, &out);
+    res = res && vec_size(out) == testSize * 100 + 4 && out[0] == -1 && out[3] == 3 && out[vec_size(out) - 1] == testSize * 200;
+    vec_setDifference_int(big, s, &out);
+    res = res && vec_size(out) == testSize * 100 - 5 && out[0] == 4;
+    res = res && !vec_setIncludes_int(big, s) && vec_setIncludes_int(s, NULL);
+    int* inter = set_fromArray(expected, 5);
+    res = res && vec_setIncludes_int(big, inter);
+    vec_free(inter);
+    vec_free(out);
+    vec_free(s);
+    vec_free(big);
+    return res;
+}
+
+// check the operations with duplicates, and vec_unique()
+static int test_vec_set_3(size_t testSize) {
+    int valuesA[] = { 1, 1, 2, 2, 2, 3 };
+    int valuesB[] = { 1, 2, 2, 4 };
+    int* a = set_fromArray(valuesA, 6);
+    int* b = set_fromArray(valuesB, 4);
+    int* out = vec_setUnion_int(a, b, NULL);
+    int res = set_equals(out, (int[]){ 1, 1, 2, 2, 2, 3, 4 }, 7);
+    vec_setIntersection_int(a, b, &out);
+    res = res && set_equals(out, (int[]){ 1, 2, 2 }, 3);
+    vec_setDifference_int(a, b, &out);
+    res = res && set_equals(out, (int[]){ 1, 2, 3 }, 3);
+    vec_setSymmetricDifference_int(a, b, &out);
+    res = res && set_equals(out, (int[]){ 1, 2, 3, 4 }, 4);
+    vec_free(out);
+    int* sub = set_fromArray((int[]){ 1, 2, 2 }, 3);
+    int* notSub = set_fromArray((int[]){ 2, 2, 2, 2 }, 4);
+    res = res && vec_setIncludes_int(a, sub) && !vec_setIncludes_int(a, notSub) && !vec_setIncludes_int(a, b);
+    res = res && vec_unique_int(&a) == 3 && set_equals(a, (int[]){ 1, 2, 3 }, 3);
+    res = res && vec_unique_int(&a) == 0;
+    // on an unsorted array only the runs of equal elements are removed
+    int* unsorted = set_fromArray((int[]){ 3, 3, 1, 3, 2, 2, 1 }, 7);
+    res = res && vec_unique_int(&unsorted) == 2 && set_equals(unsorted, (int[]){ 3, 1, 3, 2, 1 }, 5);
+    vec_free(unsorted);
+    vec_free(sub);
+    vec_free(notSub);
+    vec_free(a);
+    vec_free(b);
+    return res;
+}
+
+// check that the output array keep its memory when the results get smaller
+static int test_vec_set_4(size_t testSize) {
+    int* a = vec_create_int(testSize * 10);
+    int* b = vec_create_int(testSize * 10);
+    for(int i = 0; i < testSize * 10; i++) {
+        a[i] = i * 2;
+        b[i] = i * 2 + 1;
+    }
+    int* small = set_fromArray((int[]){ 0, 4, 5 }, 3);
+    int* out = vec_setUnion_int(a, b, NULL);
+    size_t capacity = vec_capacity(out);
+    int res = vec_size(out) == testSize * 20;
+    vec_setIntersection_int(a, small, &out);
+    res = res && set_equals(out, (int[]){ 0, 4 }, 2) && vec_capacity(out) == capacity;
+    vec_setDifference_int(small, a, &out);
+    res = res && set_equals(out, (int[]){ 5 }, 1) && vec_capacity(out) == capacity;
+    vec_setSymmetricDifference_int(a, b, &out);
+    res = res && vec_size(out) == testSize * 20 && vec_capacity(out) == capacity;
+    vec_free(small);
+    vec_free(out);
+    vec_free(a);
+    vec_free(b);
+    return res;
+}
+
+size_t test_vec_set(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_set_1,
+        test_vec_set_2,
+        test_vec_set_3,
+        test_vec_set_4
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING VEC_DEF_SET()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check inserts, lookups of present and missing keys, and overwrites
+static int test_vec_hashmap_1(size_t testSize) {
+    vec_hashmap_int_t map;
+    vec_hashmap_init_int(&map, NULL);
+    int res = vec_hashmap_find_int(&map, 0) == NULL && vec_hashmap_size_int(&map) == 0;
+    for(int i = 0; i < testSize * 100; i++) {
+        int* value = vec_hashmap_insert_int(&map, i * 7, i);
+        if(value == NULL || *value != i) res = 0;
+    }
+    res = res && vec_hashmap_size_int(&map) == testSize * 100;
+    for(int i = 0; res && i < testSize * 100; i++) {
+        int* value = vec_hashmap_find_int(&map, i * 7);
+        if(value == NULL || *value != i) res = 0;
+        if(vec_hashmap_find_int(&map, i * 7 + 1) != NULL) res = 0;
+    }
+    *vec_hashmap_insert_int(&map, 7, -1) += 1;
+    res = res && *vec_hashmap_find_int(&map, 7) == 0 && vec_hashmap_size_int(&map) == testSize * 100;
+    vec_hashmap_free_int(&map);
+    res = res && vec_hashmap_size_int(&map) == 0 && vec_hashmap_find_int(&map, 7) == NULL;
+    return res;
+}
+
+// check erase, insert after erase, the iteration and clear
+static int test_vec_hashmap_2(size_t testSize) {
+    vec_hashmap_int_t map;
+    vec_hashmap_init_int(&map, NULL);
+    int res = vec_hashmap_reserve_int(&map, testSize * 10);
+    for(int i = 0; i < testSize * 10; i++) {
+        vec_hashmap_insert_int(&map, i, i * 2);
+    }
+    for(int i = 0; i < testSize * 10; i += 2) {
+        if(!vec_hashmap_erase_int(&map, i)) res = 0;
+    }
+    res = res && !vec_hashmap_erase_int(&map, 0) && vec_hashmap_size_int(&map) == testSize * 5;
+    for(int i = 0; res && i < testSize * 10; i++) {
+        if((vec_hashmap_find_int(&map, i) == NULL) != (i % 2 == 0)) res = 0;
+    }
+    // the erased keys again, with other values
+    for(int i = 0; i < testSize * 10; i += 2) {
+        vec_hashmap_insert_int(&map, i, -i);
+    }
+    long long sum = 0;
+    size_t count = 0;
+    size_t iter = 0;
+    vec_hashmap_entry_int_t* entry;
+    while((entry = vec_hashmap_next_int(&map, &iter)) != NULL) {
+        sum += entry->key % 2 ? entry->value - entry->key * 2 : entry->value + entry->key;
+        count++;
+    }
+    res = res && sum == 0 && count == testSize * 10;
+    vec_hashmap_clear_int(&map);
+    iter = 0;
+    res = res && vec_hashmap_size_int(&map) == 0 && vec_hashmap_next_int(&map, &iter) == NULL;
+    res = res && vec_hashmap_find_int(&map, 1) == NULL && *vec_hashmap_insert_int(&map, 1, 3) == 3;
+    vec_hashmap_free_int(&map);
+    return res;
+}
+
+// check string keys, with the map allocated by a pool
+static int test_vec_hashmap_3(size_t testSize) {
+    vec_pool_t* pool = vec_pool_create();
+    vec_hashmap_str_t map;
+    vec_hashmap_init_str(&map, vec_pool_allocator(pool));
+    char (*keys)[16] = malloc(testSize * 16);
+    for(int i = 0; i < testSize; i++) {
+        sprintf(keys[i], "key%d", i);
+        vec_hashmap_insert_str(&map, keys[i], i);
+    }
+    int res = vec_hashmap_size_str(&map) == testSize;
+    for(int i = 0; res && i < testSize; i++) {
+        char key[16];
+        sprintf(key, "key%d", i);
+        int* value = vec_hashmap_find_str(&map, key);
+        if(value == NULL || *value != i) res = 0;
+    }
+    res = res && vec_hashmap_find_str(&map, "key") == NULL;
+    res = res && vec_hash_bytes("key1", 4) == vec_hash_string("key1") && vec_hash_string("") != vec_hash_string("a");
+    vec_hashmap_free_str(&map);
+    vec_pool_free(pool);
+    free(keys);
+    return res;
+}
+
+size_t test_vec_hashmap(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_hashmap_1,
+        test_vec_hashmap_2,
+        test_vec_hashmap_3
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING VEC_DEF_HASHMAP()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
+
+// check pushes and pops against a sorted copy
+static int test_vec_heap_1(size_t testSize) {
+    int* heap = vec_create_int(0);
+    int* sorted = vec_create_int(testSize * 10);
+    for(int i = 0; i < testSize * 10; i++) {
+        sorted[i] = (i * 7919) % (testSize * 10) - testSize;
+        vec_heapPush_int(&heap, sorted[i]);
+    }
+    vec_sort_int(sorted);
+    int res = vec_isHeap_int(heap) && vec_size(heap) == testSize * 10 && vec_heapTop_int(heap) == sorted[0];
+    for(size_t i = 0; res && i < testSize * 10; i++) {
+        if(vec_heapPop_int(&heap) != sorted[i] || !vec_isHeap_int(heap)) res = 0;
+    }
+    res = res && vec_size(heap) == 0;
+    // pops and pushes mixed, with duplicates
+    for(int i = 0; i < testSize; i++) {
+        vec_heapPush_int(&heap, i % 5);
+        vec_heapPush_int(&heap, i % 3);
+        vec_heapPop_int(&heap);
+    }
+    int last = vec_heapPop_int(&heap);
+    while(res && vec_size(heap) > 0) {
+        int value = vec_heapPop_int(&heap);
+        if(value < last) res = 0;
+        last = value;
+    }
+    vec_free(sorted);
+    vec_free(heap);
+    return res;
+}
+
+// check heapify and the bulk push, in both of its cases (few elements and a rebuild)
+static int test_vec_heap_2(size_t testSize) {
+    int* heap = vec_create_int(testSize * 10);
+    for(int i = 0; i < testSize * 10; i++) {
+        heap[i] = testSize * 10 - i;
+    }
+    int res = !vec_isHeap_int(heap);
+    vec_heapify_int(heap);
+    res = res && vec_isHeap_int(heap) && vec_heapTop_int(heap) == 1;
+    int few[] = { 5, 0, 3 };
+    vec_heapPushN_int(&heap, few, 3);
+    res = res && vec_isHeap_int(heap) && vec_heapTop_int(heap) == 0 && vec_size(heap) == testSize * 10 + 3;
+    int* many = vec_create_int(testSize * 20);
+    for(int i = 0; i < testSize * 20; i++) {
+        many[i] = -i;
+    }
+    vec_heapPushN_int(&heap, many, testSize * 20);
+    res = res && vec_isHeap_int(heap) && vec_heapTop_int(heap) == 1 - (int)testSize * 20;
+    res = res && vec_size(heap) == testSize * 30 + 3;
+    vec_free(many);
+    vec_free(heap);
+    return res;
+}
+
+// check a binary max heap of structs
+static int test_vec_heap_3(size_t testSize) {
+    test_struct_t* heap = vec_create_test_struct(0);
+    test_struct_t value = { 0 };
+    for(int i = 0; i < testSize; i++) {
+        value.a = (i * 31) % testSize;
+        value.c = i;
+        vec_heapPush_test_struct(&heap, value);
+    }
+    int res = vec_isHeap_test_struct(heap) && vec_heapTop_test_struct(heap).a == testSize - 1;
+    for(int i = testSize - 1; res && i >= 0; i--) {
+        if(vec_heapPop_test_struct(&heap).a != i) res = 0;
+    }
+    vec_free(heap);
+    return res;
+}
+
+size_t test_vec_heap(size_t testSize, size_t *testCase)
+{
+    subtest_func_t tests[] = {
+        test_vec_heap_1,
+        test_vec_heap_2,
+        test_vec_heap_3
+    };
+    *testCase = sizeof(tests) / sizeof(subtest_func_t);
+    printf("\n\nTESTING VEC_DEF_HEAP()\n\n");
+    return test_func(tests, *testCase, testSize);
+}
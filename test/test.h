@@ -12,6 +12,28 @@ size_t test_vec_push_front(size_t testSize, size_t* testCase);
 size_t test_vec_pop_back(size_t testSize, size_t* testCase);
 size_t test_vec_pop_front(size_t testSize, size_t* testCase);
 size_t test_vec_customStruct(size_t testSize, size_t *testCase);
+size_t test_vec_policy(size_t testSize, size_t *testCase);
+size_t test_vec_bulk(size_t testSize, size_t *testCase);
+size_t test_vec_insert_remove(size_t testSize, size_t *testCase);
+size_t test_vec_typed_sort(size_t testSize, size_t *testCase);
+size_t test_vec_radix_sort(size_t testSize, size_t *testCase);
+size_t test_vec_parallel_sort(size_t testSize, size_t *testCase);
+size_t test_vec_sorted_insert_n(size_t testSize, size_t *testCase);
+size_t test_vec_search(size_t testSize, size_t *testCase);
+size_t test_vec_reduce(size_t testSize, size_t *testCase);
+size_t test_vec_deque(size_t testSize, size_t *testCase);
+size_t test_vec_erase(size_t testSize, size_t *testCase);
+size_t test_vec_view(size_t testSize, size_t *testCase);
+size_t test_vec_allocator(size_t testSize, size_t *testCase);
+size_t test_vec_aligned(size_t testSize, size_t *testCase);
+size_t test_vec_stats(size_t testSize, size_t *testCase);
+size_t test_vec_segvec(size_t testSize, size_t *testCase);
+size_t test_vec_cache(size_t testSize, size_t *testCase);
+size_t test_vec_parallel(size_t testSize, size_t *testCase);
+size_t test_vec_pipe(size_t testSize, size_t *testCase);
+size_t test_vec_set(size_t testSize, size_t *testCase);
+size_t test_vec_hashmap(size_t testSize, size_t *testCase);
+size_t test_vec_heap(size_t testSize, size_t *testCase);
 void test_all(void);
 
 #endif // HEAD_TEST_H
\ No newline at end of file